@@ -1,7 +1,12 @@
 #ifndef INCLUDE_bencode_algorithm_hpp__
 #define INCLUDE_bencode_algorithm_hpp__
 
+#include <cstddef>
+#include <cstdint>
 #include <iterator>
+#include <limits>
+#include <string>
+#include <type_traits>
 
 
 namespace bencode
@@ -74,6 +79,223 @@ ForwardIterator copy_until(ForwardIterator __first, OutputIterator __result,
 }
 
 
+/**
+ *  @brief Status of the integer decoding.
+ */
+enum class integer_errc
+{
+    // The integer is decoded successfully.
+    success = 0,
+    // The range is empty or contains non-digit symbols.
+    not_a_number,
+    // The integer is started from the redundant leading zero.
+    leading_zero,
+    // The integer is negative zero (i.e. "-0").
+    negative_zero,
+    // The integer does not fit into the target integer type.
+    out_of_range
+};
+
+
+namespace __detail
+{
+
+
+// Check that all eight symbols of the word are decimal digits. The
+// lowest offending byte always has its high bit set either after the
+// addition or after the subtraction, since there are no carries or
+// borrows from the lower bytes, which are digits.
+inline bool
+__swar_is_digits(uint64_t __v)
+{
+    return !(((__v + 0x4646464646464646ULL) |
+        (__v - 0x3030303030303030ULL)) & 0x8080808080808080ULL);
+}
+
+
+// Convert eight decimal digits into the integer. The first digit is
+// stored in the lowest byte of the word.
+inline uint32_t
+__swar_parse_digits(uint64_t __v)
+{
+    __v -= 0x3030303030303030ULL;
+    __v = (__v * 10) + (__v >> 8);
+    __v = (((__v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))) +
+        (((__v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32))));
+    return uint32_t(__v >> 32);
+}
+
+
+// Load eight single-byte symbols into the word, the first symbol
+// becomes the lowest byte regardless of the platform byte order.
+template <typename CharT>
+inline uint64_t
+__swar_load(const CharT* __s)
+{
+    uint64_t __v = 0;
+    for (int __i = 0; __i < 8; ++__i) {
+        __v |= uint64_t(static_cast<unsigned char>(__s[__i])) << (8 * __i);
+    }
+    return __v;
+}
+
+
+// Accumulate eight digits at once into the unsigned value, that is
+// possible only for the single-byte symbols and the integer types
+// capable to keep the value of 10^8.
+template <typename UIntT, typename CharT>
+inline bool
+__swar_accumulate(const CharT*& __first, const CharT* __last,
+    UIntT& __acc, UIntT __limit, std::true_type)
+{
+    while (__last - __first >= 8) {
+        auto __word = __swar_load(__first);
+        if (!__swar_is_digits(__word)) {
+            break;
+        }
+
+        auto __chunk = UIntT(__swar_parse_digits(__word));
+        if (__acc > (__limit - __chunk) / UIntT(100000000)) {
+            return false;
+        }
+
+        __acc = __acc * UIntT(100000000) + __chunk;
+        __first += 8;
+    }
+    return true;
+}
+
+
+template <typename UIntT, typename CharT>
+inline bool
+__swar_accumulate(const CharT*&, const CharT*, UIntT&, UIntT,
+    std::false_type)
+{ return true; }
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Decode the integer from the range of symbols.
+ *
+ *  @tparam IntT   Integer type.
+ *  @tparam CharT  Character type.
+ *
+ *  @param __first  Start of the range.
+ *  @param __last   End of the range.
+ *  @param __value  Decoded integer value.
+ *
+ *  The range should consist of an optional minus sign followed by the
+ *  decimal digits without leading zeros, the negative zero is denied
+ *  as well. The @a __value is modified only on success. Returns the
+ *  status of the decoding.
+ */
+template <typename IntT, typename CharT>
+integer_errc
+decode_integer(const CharT* __first, const CharT* __last, IntT& __value)
+{
+    using uint_type = typename std::make_unsigned<IntT>::type;
+
+    bool __negative = false;
+    if (__first != __last && *__first == CharT('-')) {
+        if (!std::is_signed<IntT>::value) {
+            return integer_errc::not_a_number;
+        }
+
+        __negative = true;
+        ++__first;
+    }
+
+    if (__first == __last) {
+        return integer_errc::not_a_number;
+    }
+
+    // Only the zero itself could start from the zero digit.
+    if (*__first == CharT('0')) {
+        if (__last - __first > 1) {
+            auto __next = __first[1];
+            return __next >= CharT('0') && __next <= CharT('9') ?
+                integer_errc::leading_zero : integer_errc::not_a_number;
+        }
+        if (__negative) {
+            return integer_errc::negative_zero;
+        }
+
+        __value = IntT(0);
+        return integer_errc::success;
+    }
+
+    // The magnitude of the minimal signed value is one more than the
+    // magnitude of the maximal one.
+    auto __limit = uint_type(std::numeric_limits<IntT>::max());
+    if (__negative) {
+        __limit += 1;
+    }
+
+    uint_type __acc = 0;
+
+    using swar_type = std::integral_constant<bool, sizeof(CharT) == 1 &&
+        std::numeric_limits<uint_type>::digits >= 27>;
+
+    if (!__detail::__swar_accumulate(__first, __last, __acc, __limit,
+            swar_type())) {
+        return integer_errc::out_of_range;
+    }
+
+    for (; __first != __last; ++__first) {
+        auto __ch = *__first;
+        if (__ch < CharT('0') || __ch > CharT('9')) {
+            return integer_errc::not_a_number;
+        }
+
+        auto __digit = uint_type(__ch - CharT('0'));
+        if (__acc > (__limit - __digit) / uint_type(10)) {
+            return integer_errc::out_of_range;
+        }
+
+        __acc = __acc * uint_type(10) + __digit;
+    }
+
+    __value = __negative && __acc ?
+        IntT(-IntT(__acc - 1) - 1) : IntT(__acc);
+    return integer_errc::success;
+}
+
+
+/**
+ *  @brief Extract the symbols of the integer from the cursor.
+ *
+ *  @tparam Cursor  Input cursor type.
+ *  @tparam CharT   Character type.
+ *
+ *  @param __c  Input cursor.
+ *  @param __s  Destination array of symbols.
+ *  @param __n  Maximum count of symbols to extract.
+ *
+ *  Extracts the minus signs and decimal digits from the cursor until
+ *  any other symbol or the @a __n symbols are extracted. Returns the
+ *  count of extracted symbols.
+ */
+template <typename Cursor, typename CharT>
+std::size_t
+extract_integer(Cursor& __c, CharT* __s, std::size_t __n)
+{
+    std::size_t __count = 0;
+
+    for (; __count < __n; ++__count) {
+        auto __ch = __c.peek();
+        if (!(__ch == CharT('-') || (__ch >= CharT('0') &&
+                __ch <= CharT('9')))) {
+            break;
+        }
+        __s[__count] = CharT(__c.get());
+    }
+
+    return __count;
+}
+
+
 }
 
 
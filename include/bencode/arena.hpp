@@ -0,0 +1,415 @@
+#ifndef INCLUDE_bencode_arena_hpp__
+#define INCLUDE_bencode_arena_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <bencode/dict.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/string.hpp>
+#include <bencode/value.hpp>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#if __has_include(<memory_resource>)
+#include <memory_resource>
+#define __bencode_has_memory_resource 1
+#endif
+#endif
+
+
+namespace bencode
+{
+
+
+#if defined(__bencode_has_memory_resource)
+
+
+/**
+ *  @brief Interface of the memory resource, it is the standard one,
+ *         when it is available.
+ */
+using memory_resource = std::pmr::memory_resource;
+
+
+#else
+
+
+/**
+ *  @brief Class memory_resource.
+ *
+ *  Interface of the memory resource with the same members as the
+ *  `std::pmr::memory_resource`, which is used prior to C++17.
+ */
+class memory_resource
+{
+public:
+    virtual
+    ~memory_resource()
+    { }
+
+    void*
+    allocate(std::size_t __bytes,
+        std::size_t __alignment = alignof(std::max_align_t))
+    { return do_allocate(__bytes, __alignment); }
+
+    void
+    deallocate(void* __p, std::size_t __bytes,
+        std::size_t __alignment = alignof(std::max_align_t))
+    { do_deallocate(__p, __bytes, __alignment); }
+
+    bool
+    is_equal(const memory_resource& __r) const noexcept
+    { return do_is_equal(__r); }
+
+protected:
+    virtual void*
+    do_allocate(std::size_t __bytes, std::size_t __alignment) = 0;
+
+    virtual void
+    do_deallocate(void* __p, std::size_t __bytes,
+        std::size_t __alignment) = 0;
+
+    virtual bool
+    do_is_equal(const memory_resource& __r) const noexcept = 0;
+};
+
+
+#endif // __bencode_has_memory_resource
+
+
+/**
+ *  @brief Class monotonic_arena.
+ *
+ *  Memory resource, which hands out the memory from the growing chunks
+ *  and never frees the single allocations. The whole memory is freed at
+ *  once by `release` or by the destructor, so the values allocated from
+ *  the arena should be destroyed before.
+ */
+class monotonic_arena : public memory_resource
+{
+public:
+    /**
+     *  @brief Construct an empty arena.
+     *  @param __chunk  Size of the first chunk of memory.
+     */
+    explicit
+    monotonic_arena(std::size_t __chunk = 4096) noexcept
+    : _M_chunks(nullptr)
+    , _M_first(nullptr)
+    , _M_last(nullptr)
+    , _M_chunk_size(__chunk ? __chunk : 4096)
+    , _M_initial_size(_M_chunk_size)
+    , _M_used(0)
+    { }
+
+    monotonic_arena(const monotonic_arena&) = delete;
+
+    monotonic_arena&
+    operator=(const monotonic_arena&) = delete;
+
+    ~monotonic_arena()
+    { release(); }
+
+    /**
+     *  @brief Free all chunks of the arena at once.
+     */
+    void
+    release() noexcept
+    {
+        while (_M_chunks) {
+            auto __next = _M_chunks->_M_next;
+            ::operator delete(_M_chunks);
+            _M_chunks = __next;
+        }
+
+        _M_first = _M_last = nullptr;
+        _M_chunk_size = _M_initial_size;
+        _M_used = 0;
+    }
+
+    /**
+     *  @brief Returns the count of bytes handed out since the last release.
+     */
+    std::size_t
+    used() const noexcept
+    { return _M_used; }
+
+protected:
+    void*
+    do_allocate(std::size_t __bytes, std::size_t __alignment) override
+    {
+        auto __p = _M_align(_M_first, __alignment);
+        if (!__p || __p > _M_last ||
+                __bytes > std::size_t(_M_last - __p)) {
+            _M_grow(__bytes + __alignment);
+            __p = _M_align(_M_first, __alignment);
+        }
+
+        _M_first = __p + __bytes;
+        _M_used += __bytes;
+        return __p;
+    }
+
+    void
+    do_deallocate(void*, std::size_t, std::size_t) override
+    { }
+
+    bool
+    do_is_equal(const memory_resource& __r) const noexcept override
+    { return this == &__r; }
+
+private:
+    struct __chunk
+    {
+        __chunk* _M_next;
+        std::max_align_t _M_align;
+    };
+
+    static char*
+    _M_align(char* __p, std::size_t __alignment) noexcept
+    {
+        if (!__p) {
+            return nullptr;
+        }
+        auto __n = reinterpret_cast<std::uintptr_t>(__p);
+        __n = (__n + __alignment - 1) & ~std::uintptr_t(__alignment - 1);
+        return reinterpret_cast<char*>(__n);
+    }
+
+    void
+    _M_grow(std::size_t __bytes)
+    {
+        while (_M_chunk_size < __bytes) {
+            _M_chunk_size *= 2;
+        }
+
+        auto __size = sizeof(__chunk) + _M_chunk_size;
+        auto __ptr = static_cast<__chunk*>(::operator new(__size));
+
+        __ptr->_M_next = _M_chunks;
+        _M_chunks = __ptr;
+        _M_first = reinterpret_cast<char*>(__ptr + 1);
+        _M_last = _M_first + _M_chunk_size;
+
+        // The chunks grow geometrically, so the count of the chunks stays
+        // logarithmic to the size of the document.
+        _M_chunk_size *= 2;
+    }
+
+    __chunk* _M_chunks;
+    char* _M_first;
+    char* _M_last;
+    std::size_t _M_chunk_size;
+    std::size_t _M_initial_size;
+    std::size_t _M_used;
+};
+
+
+namespace __detail
+{
+
+
+// The resource used by the default constructed arena allocators of the
+// current thread, the global heap is used when it is `nullptr`.
+inline memory_resource*&
+__current_resource() noexcept
+{
+    static thread_local memory_resource* __resource = nullptr;
+    return __resource;
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Class arena_scope.
+ *
+ *  Make the memory resource current for the default constructed arena
+ *  allocators of the calling thread, until the scope is left.
+ */
+class arena_scope
+{
+public:
+    explicit
+    arena_scope(memory_resource& __r) noexcept
+    : _M_previous(__detail::__current_resource())
+    { __detail::__current_resource() = &__r; }
+
+    arena_scope(const arena_scope&) = delete;
+
+    arena_scope&
+    operator=(const arena_scope&) = delete;
+
+    ~arena_scope()
+    { __detail::__current_resource() = _M_previous; }
+
+private:
+    memory_resource* _M_previous;
+};
+
+
+/**
+ *  @brief Template class arena_allocator.
+ *
+ *  @tparam T  Type of the allocated values.
+ *
+ *  Allocator, which takes the memory from the memory resource. The
+ *  default constructed allocator uses the resource of the innermost
+ *  `arena_scope` of the calling thread, or the global heap without it.
+ *  Since the value classes construct their strings and containers with
+ *  the default allocators, the value types with this allocator place
+ *  everything to the resource, which is current during the decoding.
+ *  The copies of the containers take the resource current at the moment
+ *  of the copy.
+ */
+template <typename T>
+class arena_allocator
+{
+public:
+    using value_type = T;
+
+    arena_allocator() noexcept
+    : _M_resource(__detail::__current_resource())
+    { }
+
+    arena_allocator(memory_resource* __r) noexcept
+    : _M_resource(__r)
+    { }
+
+    template <typename U>
+    arena_allocator(const arena_allocator<U>& __a) noexcept
+    : _M_resource(__a.resource())
+    { }
+
+    T*
+    allocate(std::size_t __n)
+    {
+        if (!_M_resource) {
+            return static_cast<T*>(::operator new(__n * sizeof(T)));
+        }
+        return static_cast<T*>(
+            _M_resource->allocate(__n * sizeof(T), alignof(T)));
+    }
+
+    void
+    deallocate(T* __p, std::size_t __n) noexcept
+    {
+        if (!_M_resource) {
+            ::operator delete(__p);
+        } else {
+            _M_resource->deallocate(__p, __n * sizeof(T), alignof(T));
+        }
+    }
+
+    arena_allocator
+    select_on_container_copy_construction() const noexcept
+    { return arena_allocator(); }
+
+    /**
+     *  @brief Returns the memory resource, `nullptr` is the global heap.
+     */
+    memory_resource*
+    resource() const noexcept
+    { return _M_resource; }
+
+private:
+    memory_resource* _M_resource;
+};
+
+
+template <typename T, typename U>
+bool
+operator==(const arena_allocator<T>& __a, const arena_allocator<U>& __b)
+    noexcept
+{
+    return __a.resource() == __b.resource() || (__a.resource() &&
+        __b.resource() && __a.resource()->is_equal(*__b.resource()));
+}
+
+
+template <typename T, typename U>
+bool
+operator!=(const arena_allocator<T>& __a, const arena_allocator<U>& __b)
+    noexcept
+{ return !(__a == __b); }
+
+
+template
+< typename CharT = char
+, typename Traits = std::char_traits<CharT>
+> using basic_arena_string = basic_string<CharT, Traits, arena_allocator>;
+
+
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> using basic_arena_list = basic_list<CharT, IntT, Traits, arena_allocator>;
+
+
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> using basic_arena_dict = basic_dict<CharT, IntT, Traits, arena_allocator>;
+
+
+typedef basic_arena_string<char> arena_string;
+
+
+typedef basic_arena_list<char> arena_list;
+
+
+typedef basic_arena_dict<char> arena_dict;
+
+
+/**
+ *  @brief Parse bencoded value into the memory resource.
+ *
+ *  @tparam CharT          Character type.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  @param __s         Start of the range.
+ *  @param __n         Count of characters in the range.
+ *  @param __resource  Memory resource, for example `monotonic_arena`.
+ *
+ *  The values, the control blocks of the shared pointers, the keys, the
+ *  strings and the storage of the containers are all allocated from the
+ *  resource, so the decoding does not touch the global heap, when the
+ *  resource does not. The values are of the `basic_arena_*` types and
+ *  should be destroyed before the resource is released.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+, template
+  < typename Key
+  , typename T
+  , typename... Args
+  > class DictContainer = std::map
+, template
+  < typename T
+  , typename... Args
+  > class ListContainer = std::vector
+> std::pair<std::shared_ptr<basic_value<CharT, Traits>>, std::size_t>
+parse(const CharT* __s, std::size_t __n, memory_resource& __resource)
+{
+    arena_scope __scope(__resource);
+    return parse<CharT, IntT, Traits, arena_allocator, DictContainer,
+        ListContainer>(__s, __n);
+}
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_arena_hpp__
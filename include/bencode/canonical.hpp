@@ -0,0 +1,309 @@
+#ifndef INCLUDE_bencode_canonical_hpp__
+#define INCLUDE_bencode_canonical_hpp__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bencode/error.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+#include <bencode/skip.hpp>
+#include <bencode/validate.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+namespace __detail
+{
+
+
+// Compare the raw characters of the keys, the shorter key is less than
+// the longer key with the same prefix.
+template <typename CharT, typename Traits>
+int
+__compare_keys(const CharT* __a, std::size_t __an, const CharT* __b,
+    std::size_t __bn)
+{
+    auto __c = Traits::compare(__a, __b, std::min(__an, __bn));
+    if (__c) {
+        return __c;
+    }
+    return __an < __bn ? -1 : (__an > __bn ? 1 : 0);
+}
+
+
+// Handler of the validation, which requires the keys of each dictionary
+// to be strictly increasing.
+template <typename CharT, typename Traits>
+struct __canonical_handler
+{
+    // The last key of the dictionary at each nesting level.
+    std::vector<std::pair<const CharT*, std::size_t>> _M_keys;
+
+    void
+    begin_dict(std::size_t __level)
+    {
+        if (_M_keys.size() <= __level) {
+            _M_keys.resize(__level + 1);
+        }
+        _M_keys[__level].first = nullptr;
+    }
+
+    errc
+    key(std::size_t __level, const CharT*, const CharT* __key,
+        std::size_t __length)
+    {
+        auto& __last = _M_keys[__level];
+
+        if (__last.first) {
+            auto __c = __compare_keys<CharT, Traits>(
+                __last.first, __last.second, __key, __length);
+            if (__c == 0) {
+                return errc::duplicate_key;
+            }
+            if (__c > 0) {
+                return errc::unsorted_keys;
+            }
+        }
+
+        __last = std::make_pair(__key, __length);
+        return errc::success;
+    }
+};
+
+
+// Item of the dictionary, which is reordered.
+template <typename CharT>
+struct __canonical_item
+{
+    const CharT* _M_token;
+    const CharT* _M_key;
+    std::size_t _M_length;
+    const CharT* _M_value;
+};
+
+
+// Append the canonical form of the well-formed value at the specified
+// position to the string. The scalars are copied verbatim, only the
+// items of the unsorted dictionaries are reordered. Returns the pointer
+// right past the value.
+template <typename CharT, typename IntT, typename Traits>
+const CharT*
+__canonical_copy(const CharT* __p, const CharT* __last,
+    std::basic_string<CharT, Traits>& __out)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+    using item_type = __canonical_item<CharT>;
+
+    __skip_handler<CharT, IntT> __skip;
+
+    auto __ch = *__p;
+    if (__ch == basic_value_type::list_token) {
+        __out.push_back(*__p++);
+        while (*__p != basic_value_type::end_token) {
+            __p = __canonical_copy<CharT, IntT, Traits>(__p, __last, __out);
+        }
+        __out.push_back(*__p++);
+        return __p;
+    }
+
+    if (__ch != basic_value_type::dict_token) {
+        auto __end = __walk_structure<CharT, IntT, Traits>(
+            __p, __p, __last, __skip, "bencode::canonicalize");
+        __out.append(__p, __end);
+        return __end;
+    }
+
+    std::vector<item_type> __items;
+    bool __sorted = true;
+
+    ++__p;
+    while (*__p != basic_value_type::end_token) {
+        item_type __item;
+        __item._M_token = __p;
+
+        __p = __scan_string<CharT, Traits>(
+            __p, __p, __last, __item._M_length, "bencode::canonicalize");
+        __item._M_key = __p - __item._M_length;
+        __item._M_value = ++__p;
+
+        if (!__items.empty() && __compare_keys<CharT, Traits>(
+                __items.back()._M_key, __items.back()._M_length,
+                __item._M_key, __item._M_length) >= 0) {
+            __sorted = false;
+        }
+
+        __items.push_back(__item);
+        __p = __walk_structure<CharT, IntT, Traits>(
+            __p, __p, __last, __skip, "bencode::canonicalize");
+    }
+    auto __end = __p + 1;
+
+    // The stable sort keeps the first item of the duplicate keys in
+    // front, the same item is kept by the decoding.
+    if (!__sorted) {
+        std::stable_sort(__items.begin(), __items.end(),
+            [](const item_type& __a, const item_type& __b) {
+                return __compare_keys<CharT, Traits>(__a._M_key,
+                    __a._M_length, __b._M_key, __b._M_length) < 0;
+            });
+    }
+
+    __out.push_back(basic_value_type::dict_token);
+    for (std::size_t __i = 0; __i < __items.size(); ++__i) {
+        auto& __item = __items[__i];
+        if (__i && __compare_keys<CharT, Traits>(
+                __items[__i-1]._M_key, __items[__i-1]._M_length,
+                __item._M_key, __item._M_length) == 0) {
+            continue;
+        }
+
+        __out.append(__item._M_token, __item._M_value);
+        __canonical_copy<CharT, IntT, Traits>(
+            __item._M_value, __last, __out);
+    }
+    __out.push_back(basic_value_type::end_token);
+    return __end;
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Check that the range contains the single value in the
+ *         canonical form.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s      Start of the range.
+ *  @param __n      Count of characters in the range.
+ *  @param __depth  Maximum nesting depth, which is limited to 4096.
+ *
+ *  Additionally to the checks of `validate`, the keys of the dictionaries
+ *  should be sorted by their raw characters without duplicates. The
+ *  range is checked in a single pass without exceptions. Returns the kind
+ *  and the offset of the first violation.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> validate_result
+is_canonical(const CharT* __s, std::size_t __n, std::size_t __depth = 512)
+{
+    __detail::__canonical_handler<CharT, Traits> __handler;
+    return __detail::__validate<CharT, IntT, Traits>(
+        __s, __n, __depth, __handler);
+}
+
+
+/**
+ *  @brief Check that the string contains the single value in the
+ *         canonical form.
+ *
+ *  @tparam CharT        Character type.
+ *  @tparam IntT         Integer type, defaults to `int64_t`.
+ *  @tparam Traits       Traits for character type, defaults to
+ *                       `std::char_traits<CharT>`.
+ *  @tparam StringAlloc  Allocator type of the string.
+ *
+ *  @param __str    Source string.
+ *  @param __depth  Maximum nesting depth, which is limited to 4096.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+, typename StringAlloc
+> validate_result
+is_canonical(const std::basic_string<CharT, Traits, StringAlloc>& __str,
+    std::size_t __depth = 512)
+{
+    return is_canonical<CharT, IntT, Traits>(
+        __str.data(), __str.size(), __depth);
+}
+
+
+/**
+ *  @brief Convert the value into the canonical form.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s  Start of the range.
+ *  @param __n  Count of characters in the range.
+ *
+ *  The value is not decoded. The items of the dictionaries with unsorted
+ *  keys are reordered, the duplicate keys are dropped, except of the
+ *  first one, everything else is copied verbatim. The range, which is
+ *  already canonical, is copied at once. Throws `encoding_error` when
+ *  the range does not contain the single well-formed value.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::basic_string<CharT, Traits>
+canonicalize(const CharT* __s, std::size_t __n)
+{
+    auto __r = is_canonical<CharT, IntT, Traits>(__s, __n);
+    if (__r) {
+        return std::basic_string<CharT, Traits>(__s, __n);
+    }
+
+    // The order of the keys is fixable, but the rest of the value should
+    // be well-formed.
+    if (__r.code == errc::unsorted_keys || __r.code == errc::duplicate_key) {
+        __r = validate<CharT, IntT, Traits>(__s, __n);
+    }
+    if (!__r) {
+        std::ostringstream __error;
+
+        __error << "bencode::canonicalize "
+            << make_error_code(__r.code).message()
+            << " at offset " << __r.offset << "\n";
+        __bencode_throw(encoding_error(__error.str()));
+    }
+
+    std::basic_string<CharT, Traits> __out;
+    __out.reserve(__n);
+    __detail::__canonical_copy<CharT, IntT, Traits>(__s, __s + __n, __out);
+    return __out;
+}
+
+
+/**
+ *  @brief Convert the value in the string into the canonical form.
+ *
+ *  @tparam CharT        Character type.
+ *  @tparam IntT         Integer type, defaults to `int64_t`.
+ *  @tparam Traits       Traits for character type, defaults to
+ *                       `std::char_traits<CharT>`.
+ *  @tparam StringAlloc  Allocator type of the string.
+ *
+ *  @param __str  Source string.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+, typename StringAlloc
+> std::basic_string<CharT, Traits>
+canonicalize(const std::basic_string<CharT, Traits, StringAlloc>& __str)
+{ return canonicalize<CharT, IntT, Traits>(__str.data(), __str.size()); }
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_canonical_hpp__
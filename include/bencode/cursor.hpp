@@ -0,0 +1,436 @@
+#ifndef INCLUDE_bencode_cursor_hpp__
+#define INCLUDE_bencode_cursor_hpp__
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <streambuf>
+#include <string>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Template class basic_buffer_cursor.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  A cursor over the contiguous range of characters. The cursor does
+ *  not own the underlying memory, it only advances the pointer to the
+ *  current character, so the range should outlive the cursor.
+ */
+template
+< typename CharT = char
+, typename Traits = std::char_traits<CharT>
+> class basic_buffer_cursor
+{
+public:
+    using char_type = CharT;
+
+    using traits_type = Traits;
+
+    using int_type = typename Traits::int_type;
+
+    /**
+     *  @brief Construct a cursor over the range of characters.
+     *  @param __first  Start of the range.
+     *  @param __last   End of the range.
+     */
+    basic_buffer_cursor(const CharT* __first, const CharT* __last)
+    : _M_first(__first), _M_current(__first), _M_last(__last)
+    { }
+
+    /**
+     *  @brief Construct a cursor over the range of characters.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     */
+    basic_buffer_cursor(const CharT* __s, std::size_t __n)
+    : basic_buffer_cursor(__s, __s + __n)
+    { }
+
+    /**
+     *  @brief Return the current character without extracting it.
+     *
+     *  Returns `Traits::eof()` when the end of the range is reached.
+     */
+    int_type
+    peek() const
+    {
+        return _M_current != _M_last ?
+            Traits::to_int_type(*_M_current) : Traits::eof();
+    }
+
+    /**
+     *  @brief Extract the current character.
+     *
+     *  Returns `Traits::eof()` when the end of the range is reached.
+     */
+    int_type
+    get()
+    {
+        return _M_current != _M_last ?
+            Traits::to_int_type(*_M_current++) : Traits::eof();
+    }
+
+    /**
+     *  @brief Extract the characters into the specified array.
+     *  @param __s  Destination array of characters.
+     *  @param __n  Count of characters to extract.
+     *
+     *  Returns the count of actually extracted characters, it could be
+     *  less than @a __n when the end of the range is reached.
+     */
+    std::size_t
+    read(CharT* __s, std::size_t __n)
+    {
+        if (__n > remaining()) {
+            __n = remaining();
+        }
+
+        Traits::copy(__s, _M_current, __n);
+        _M_current += __n;
+        return __n;
+    }
+
+    /**
+     *  @brief Skip the specified count of characters.
+     *  @param __n  Count of characters to skip.
+     *
+     *  Returns the count of actually skipped characters, it could be
+     *  less than @a __n when the end of the range is reached.
+     */
+    std::size_t
+    ignore(std::size_t __n)
+    {
+        if (__n > remaining()) {
+            __n = remaining();
+        }
+
+        _M_current += __n;
+        return __n;
+    }
+
+    /**
+     *  @brief Check that the specified count of characters could be
+     *         extracted from the range.
+     *  @param __n  Count of characters.
+     */
+    bool
+    available(std::size_t __n) const
+    { return __n <= remaining(); }
+
+    /**
+     *  @brief Returns the count of characters left in the range.
+     */
+    std::size_t
+    remaining() const
+    { return std::size_t(_M_last - _M_current); }
+
+    /**
+     *  @brief Returns the count of characters extracted so far.
+     */
+    std::size_t
+    position() const
+    { return std::size_t(_M_current - _M_first); }
+
+    /**
+     *  @brief Returns the pointer to the current character.
+     */
+    const CharT*
+    current() const
+    { return _M_current; }
+
+private:
+    const CharT* _M_first;
+    const CharT* _M_current;
+    const CharT* _M_last;
+};
+
+
+/**
+ *  @brief Template class basic_streambuf_cursor.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  A cursor over the stream buffer, which is used to adapt the input
+ *  streams to the decoders of the Bencode values.
+ */
+template
+< typename CharT = char
+, typename Traits = std::char_traits<CharT>
+> class basic_streambuf_cursor
+{
+public:
+    using char_type = CharT;
+
+    using traits_type = Traits;
+
+    using int_type = typename Traits::int_type;
+
+    using streambuf_type = std::basic_streambuf<CharT, Traits>;
+
+    using istream_type = std::basic_istream<CharT, Traits>;
+
+    /**
+     *  @brief Construct a cursor over the stream buffer.
+     *  @param __sb  Source stream buffer.
+     */
+    explicit
+    basic_streambuf_cursor(streambuf_type* __sb)
+    : _M_sb(__sb), _M_pos(0)
+    { }
+
+    /**
+     *  @brief Construct a cursor over the buffer of the input stream.
+     *  @param __s  Source input stream.
+     *
+     *  When the stream is not ready for the input, the cursor behaves
+     *  as it reached the end of the stream.
+     */
+    explicit
+    basic_streambuf_cursor(istream_type& __s)
+    : _M_sb(nullptr), _M_pos(0)
+    {
+        typename istream_type::sentry __sentry(__s, true);
+        if (__sentry) {
+            _M_sb = __s.rdbuf();
+        }
+    }
+
+    /**
+     *  @brief Return the current character without extracting it.
+     *
+     *  Returns `Traits::eof()` when the end of the stream is reached.
+     */
+    int_type
+    peek() const
+    { return _M_sb ? _M_sb->sgetc() : Traits::eof(); }
+
+    /**
+     *  @brief Extract the current character.
+     *
+     *  Returns `Traits::eof()` when the end of the stream is reached.
+     */
+    int_type
+    get()
+    {
+        if (!_M_sb) {
+            return Traits::eof();
+        }
+
+        auto __ch = _M_sb->sbumpc();
+        if (!Traits::eq_int_type(__ch, Traits::eof())) {
+            ++_M_pos;
+        }
+        return __ch;
+    }
+
+    /**
+     *  @brief Extract the characters into the specified array.
+     *  @param __s  Destination array of characters.
+     *  @param __n  Count of characters to extract.
+     *
+     *  Returns the count of actually extracted characters, it could be
+     *  less than @a __n when the end of the stream is reached.
+     */
+    std::size_t
+    read(CharT* __s, std::size_t __n)
+    {
+        if (!_M_sb) {
+            return 0;
+        }
+
+        // Extract the whole block of characters at once, so the stream
+        // buffer could copy them directly from the get area.
+        auto __count = std::size_t(_M_sb->sgetn(__s, std::streamsize(__n)));
+        _M_pos += __count;
+        return __count;
+    }
+
+    /**
+     *  @brief Skip the specified count of characters.
+     *  @param __n  Count of characters to skip.
+     *
+     *  The characters known to be available are seeked over, when the
+     *  stream buffer supports it, otherwise they are extracted one by
+     *  one. Returns the count of actually skipped characters, it could
+     *  be less than @a __n when the end of the stream is reached.
+     */
+    std::size_t
+    ignore(std::size_t __n)
+    {
+        using off_type = typename Traits::off_type;
+
+        std::size_t __count = 0;
+        bool __seekable = _M_sb != nullptr;
+
+        while (__count < __n) {
+            auto __avail = __seekable ? _M_sb->in_avail() : 0;
+
+            if (__avail > 0) {
+                auto __step = std::size_t(__avail);
+                if (__step > __n - __count) {
+                    __step = __n - __count;
+                }
+
+                auto __pos = _M_sb->pubseekoff(off_type(__step),
+                    std::ios_base::cur, std::ios_base::in);
+                if (__pos != typename Traits::pos_type(off_type(-1))) {
+                    __count += __step;
+                    _M_pos += __step;
+                    continue;
+                }
+                __seekable = false;
+            }
+
+            if (Traits::eq_int_type(get(), Traits::eof())) {
+                break;
+            }
+            ++__count;
+        }
+
+        return __count;
+    }
+
+    /**
+     *  @brief Check that the specified count of characters could be
+     *         extracted from the stream.
+     *  @param __n  Count of characters.
+     *
+     *  Returns False only when the stream buffer knows for sure, that
+     *  less than @a __n characters are left, True otherwise. When the
+     *  characters are not in the get area already, the end of the
+     *  stream is looked up, if the stream buffer supports seeking.
+     */
+    bool
+    available(std::size_t __n) const
+    {
+        using off_type = typename Traits::off_type;
+        using pos_type = typename Traits::pos_type;
+
+        if (!_M_sb) {
+            return !__n;
+        }
+
+        auto __avail = _M_sb->in_avail();
+        if (__avail < 0) {
+            return !__n;
+        }
+        if (std::size_t(__avail) >= __n) {
+            return true;
+        }
+
+        auto __cur = _M_sb->pubseekoff(off_type(0), std::ios_base::cur,
+            std::ios_base::in);
+        if (__cur == pos_type(off_type(-1))) {
+            return true;
+        }
+
+        auto __end = _M_sb->pubseekoff(off_type(0), std::ios_base::end,
+            std::ios_base::in);
+        _M_sb->pubseekpos(__cur, std::ios_base::in);
+
+        if (__end == pos_type(off_type(-1))) {
+            return true;
+        }
+        return std::size_t(off_type(__end - __cur)) >= __n;
+    }
+
+    /**
+     *  @brief Returns the count of characters known to be left in the
+     *         stream.
+     *
+     *  Only the characters of the get area are counted, so the stream
+     *  could be longer.
+     */
+    std::size_t
+    remaining() const
+    {
+        auto __avail = _M_sb ? _M_sb->in_avail() : 0;
+        return __avail > 0 ? std::size_t(__avail) : 0;
+    }
+
+    /**
+     *  @brief Returns the count of characters extracted so far.
+     */
+    std::size_t
+    position() const
+    { return _M_pos; }
+
+private:
+    streambuf_type* _M_sb;
+    std::size_t _M_pos;
+};
+
+
+namespace __detail
+{
+
+
+// Count of characters extracted at once from the input, which end is
+// not known.
+const std::size_t __read_chunk = 4096;
+
+
+// Read the specified count of characters from the cursor into the string.
+// When the cursor does not know, that the characters are there, the
+// string grows with the extracted characters by the bounded steps, so
+// the declared, but missing characters are never allocated. Returns
+// False on the short read.
+template <typename Cursor, typename String>
+bool
+__read_payload(Cursor& __c, String& __str, std::size_t __n)
+{
+    // Do not allocate the memory for the payload, which is known
+    // to be truncated.
+    if (!__c.available(__n)) {
+        return false;
+    }
+
+    if (__c.remaining() >= __n) {
+        __str.resize(__n);
+        return __c.read(&__str[0], __n) == __n;
+    }
+
+    __str.clear();
+    while (__str.size() < __n) {
+        auto __size = __str.size();
+        auto __step = std::min(__n - __size, std::max(__size, __read_chunk));
+
+        __str.resize(__size + __step);
+        auto __count = __c.read(&__str[__size], __step);
+
+        if (__count != __step) {
+            __str.resize(__size + __count);
+            return false;
+        }
+    }
+    return true;
+}
+
+
+} // namespace __detail
+
+
+typedef basic_buffer_cursor<char> buffer_cursor;
+
+
+typedef basic_buffer_cursor<wchar_t> wbuffer_cursor;
+
+
+typedef basic_streambuf_cursor<char> streambuf_cursor;
+
+
+typedef basic_streambuf_cursor<wchar_t> wstreambuf_cursor;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_cursor_hpp__
@@ -0,0 +1,251 @@
+#ifndef INCLUDE_bencode_decode_hpp__
+#define INCLUDE_bencode_decode_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <bencode/algorithm.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/error.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/string.hpp>
+#include <bencode/validate.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Template struct basic_decode_result.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  The result of the decoding, which does not throw exceptions.
+ */
+template
+< typename CharT = char
+, typename Traits = std::char_traits<CharT>
+> struct basic_decode_result
+{
+    // The decoded value, it is `nullptr` on error.
+    std::shared_ptr<basic_value<CharT, Traits>> value;
+
+    // The kind of the error, or `errc::success`.
+    errc code;
+
+    // The offset of the error, or the count of the consumed characters.
+    std::size_t offset;
+
+    /**
+     *  @brief Returns True when the value is decoded.
+     */
+    explicit
+    operator bool() const noexcept
+    { return code == errc::success; }
+
+    /**
+     *  @brief Returns the error code of the decoding.
+     */
+    std::error_code
+    error() const noexcept
+    { return make_error_code(code); }
+};
+
+
+namespace __detail
+{
+
+
+// Build the value from the range, which is already validated, so none
+// of the checks are repeated and nothing is thrown except of the memory
+// allocation failures. The nesting is tracked on the explicit stack.
+template<__bencode_dict_template>
+std::shared_ptr<basic_value<CharT, Traits>>
+__build_value(const CharT* __p)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+    using integer_type = basic_integer<__bencode_integer_typenames>;
+    using string_type = basic_string<__bencode_string_typenames>;
+    using list_type = basic_list<__bencode_list_typenames>;
+    using dict_type = basic_dict<__bencode_dict_typenames>;
+    using chars_type = typename string_type::string_type;
+
+    struct __frame
+    {
+        list_type* _M_list;
+        dict_type* _M_dict;
+    };
+
+    // Read the string token and move the position past its payload.
+    auto __chars = [&__p]() {
+        std::size_t __length = 0;
+        for (; *__p != basic_value_type::delimiter_token; ++__p) {
+            __length = __length * 10 + std::size_t(*__p - CharT('0'));
+        }
+        chars_type __s(++__p, __length);
+        __p += __length;
+        return __s;
+    };
+
+    std::vector<__frame> __stack;
+    value_ptr_type __root;
+    string_type __key;
+    bool __has_key = false;
+
+    for (;;) {
+        auto __ch = *__p;
+
+        if (!__stack.empty()) {
+            if (__ch == basic_value_type::end_token) {
+                ++__p;
+                __stack.pop_back();
+                if (__stack.empty()) {
+                    return __root;
+                }
+                continue;
+            }
+
+            if (__stack.back()._M_dict && !__has_key) {
+                __key = string_type(__chars());
+                __has_key = true;
+                ++__p;
+                continue;
+            }
+        }
+
+        value_ptr_type __value;
+        __frame __pushed = {nullptr, nullptr};
+
+        if (__ch == basic_value_type::integer_token) {
+            auto __digits = ++__p;
+            while (*__p != basic_value_type::end_token) {
+                ++__p;
+            }
+
+            IntT __i = 0;
+            decode_integer(__digits, __p++, __i);
+            __value = __allocate_value<integer_type, Allocator>(__i);
+        } else if (__ch == basic_value_type::list_token) {
+            auto __ptr = __allocate_value<list_type, Allocator>();
+            __pushed._M_list = __ptr.get();
+            __value = __ptr;
+            ++__p;
+        } else if (__ch == basic_value_type::dict_token) {
+            auto __ptr = __allocate_value<dict_type, Allocator>();
+            __pushed._M_dict = __ptr.get();
+            __value = __ptr;
+            ++__p;
+        } else {
+            __value = __allocate_value<string_type, Allocator>(__chars());
+        }
+
+        if (__stack.empty()) {
+            __root = __value;
+        } else if (__stack.back()._M_list) {
+            __stack.back()._M_list->insert(__value);
+        } else {
+            // The first value of the duplicate key is kept, the same as
+            // the throwing decoder does.
+            __stack.back()._M_dict->insert(
+                typename dict_type::value_type(__key, __value));
+            __has_key = false;
+        }
+
+        if (__pushed._M_list || __pushed._M_dict) {
+            __stack.push_back(__pushed);
+        } else if (__stack.empty()) {
+            return __root;
+        }
+    }
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Parse bencoded value without throwing exceptions.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  @param __s      Start of the range.
+ *  @param __n      Count of characters in the range.
+ *  @param __depth  Maximum nesting depth, which is limited to 4096.
+ *
+ *  The first value of the range is validated with the same rules as
+ *  `validate` and then decoded. The characters after the value are left
+ *  untouched. Malformed input is reported with the kind and the offset
+ *  of the first error instead of the exception, so the function could be
+ *  used in the builds without exceptions.
+ */
+template<__bencode_dict_template>
+basic_decode_result<CharT, Traits>
+try_parse(const CharT* __s, std::size_t __n, std::size_t __depth = 512)
+{
+    using result_type = basic_decode_result<CharT, Traits>;
+
+    __detail::__validate_handler __handler;
+    auto __r = __detail::__validate<CharT, IntT, Traits>(
+        __s, __n, __depth, __handler);
+
+    // The value is complete, when only the trailing symbols are left.
+    if (__r.code == errc::trailing_data) {
+        __r.code = errc::success;
+    }
+    if (!__r) {
+        return result_type{nullptr, __r.code, __r.offset};
+    }
+
+    auto __ptr = __detail::__build_value<__bencode_dict_typenames>(__s);
+    return result_type{__ptr, errc::success, __r.offset};
+}
+
+
+/**
+ *  @brief Parse bencoded value reporting the errors into the error code.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  @param __s   Start of the range.
+ *  @param __n   Count of characters in the range.
+ *  @param __ec  Error code, which is cleared on success.
+ *
+ *  Returns a pair of the shared pointer to the decoded value and the
+ *  count of characters consumed from the range. On error the pointer is
+ *  `nullptr` and the second element is the offset of the error.
+ */
+template<__bencode_dict_template>
+std::pair<std::shared_ptr<basic_value<CharT, Traits>>, std::size_t>
+parse(const CharT* __s, std::size_t __n, std::error_code& __ec)
+{
+    auto __r = try_parse<__bencode_dict_typenames>(__s, __n);
+    __ec = __r.error();
+    return std::make_pair(__r.value, __r.offset);
+}
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_decode_hpp__
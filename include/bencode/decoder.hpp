@@ -0,0 +1,312 @@
+#ifndef INCLUDE_bencode_decoder_hpp__
+#define INCLUDE_bencode_decoder_hpp__
+
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <sstream>
+#include <utility>
+#include <vector>
+#include <bencode/cursor.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/string.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Template class basic_decoder.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  Decode the values without the recursion. The nesting is tracked on
+ *  the explicit stack allocated on the heap, so the usage of the thread
+ *  stack does not depend on the input. The stack is kept between the
+ *  calls, so a single decoder could be reused for many values. The
+ *  nesting depth is limited to reject the adversarial input.
+ */
+template<__bencode_dict_template>
+class basic_decoder
+{
+private:
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    using integer_type = basic_integer<__bencode_integer_typenames>;
+
+    using string_type = basic_string<__bencode_string_typenames>;
+
+    using list_type = basic_list<__bencode_list_typenames>;
+
+    using dict_type = basic_dict<__bencode_dict_typenames>;
+
+    // The container, which is being decoded, and the key of the
+    // dictionary item, which value is expected next.
+    struct __frame
+    {
+        list_type* _M_list;
+        dict_type* _M_dict;
+        string_type _M_key;
+        bool _M_has_key;
+    };
+
+public:
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Default maximum nesting depth.
+     */
+    static const size_type default_depth = 512;
+
+    /**
+     *  @brief Construct a decoder with the maximum nesting depth.
+     *  @param __depth  Maximum count of the nested containers.
+     */
+    explicit
+    basic_decoder(size_type __depth = default_depth)
+    : _M_depth(__depth), _M_size(0)
+    { }
+
+    /**
+     *  @brief Returns the maximum nesting depth.
+     */
+    size_type
+    max_depth() const
+    { return _M_depth; }
+
+    /**
+     *  @brief Change the maximum nesting depth.
+     *  @param __depth  Maximum count of the nested containers.
+     *
+     *  The decoded values are still destroyed and dumped recursively,
+     *  so the depth also bounds the stack usage of those operations,
+     *  and should not be raised far above the default.
+     */
+    void
+    max_depth(size_type __depth)
+    { _M_depth = __depth; }
+
+    /**
+     *  @brief Decode the value from the specified cursor.
+     *  @param __c  Reference to the input cursor.
+     *
+     *  Throws `value_error` when the nesting depth is exceeded and the
+     *  same exceptions as the container decoders on malformed input.
+     */
+    template <typename Cursor>
+    value_ptr_type
+    decode(Cursor& __c)
+    {
+        // The frames of the previous call could be left after the error,
+        // but their storage is reused.
+        _M_size = 0;
+        _M_root = nullptr;
+
+        for (;;) {
+            auto __ch = __c.peek();
+
+            if (_M_size) {
+                auto& __top = _M_stack[_M_size - 1];
+
+                if (__ch == basic_value_type::end_token) {
+                    if (__top._M_dict && __top._M_has_key) {
+                        std::ostringstream __error;
+
+                        __error << "bencode::decoder the value of the "
+                            "key expected, but `e` found at offset "
+                            << __c.position() << "\n";
+                        __bencode_throw(encoding_error(__error.str()));
+                    }
+
+                    __c.get();
+                    --_M_size;
+
+                    if (!_M_size) {
+                        return std::move(_M_root);
+                    }
+                    continue;
+                }
+
+                if (Traits::eq_int_type(__ch, Traits::eof())) {
+                    std::ostringstream __error;
+
+                    __error << "bencode::decoder the end of the "
+                        << (__top._M_list ? "list" : "dictionary")
+                        << " `e` expected, but the end of the stream "
+                        "found\n";
+                    __bencode_throw(encoding_error(__error.str()));
+                }
+
+                if (__top._M_dict && !__top._M_has_key) {
+                    _M_key(__c, __top);
+                    continue;
+                }
+            }
+
+            switch (__ch)
+            {
+            case basic_value_type::integer_token: {
+                auto __ptr = __detail::__allocate_value<
+                    integer_type, Allocator>();
+                __ptr->decode(__c);
+                _M_attach(__ptr);
+                break;
+            }
+            case basic_value_type::list_token: {
+                auto __ptr = __detail::__allocate_value<
+                    list_type, Allocator>();
+                __c.get();
+                _M_attach(__ptr);
+                _M_push(__c, __ptr.get(), nullptr);
+                break;
+            }
+            case basic_value_type::dict_token: {
+                auto __ptr = __detail::__allocate_value<
+                    dict_type, Allocator>();
+                __c.get();
+                _M_attach(__ptr);
+                _M_push(__c, nullptr, __ptr.get());
+                break;
+            }
+            default: {
+                auto __ptr = __detail::__allocate_value<
+                    string_type, Allocator>();
+                __ptr->decode(__c);
+                _M_attach(__ptr);
+                break;
+            }
+            }
+
+            if (!_M_size) {
+                return std::move(_M_root);
+            }
+        }
+    }
+
+    /**
+     *  @brief Decode the value from the contiguous range of characters.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     *
+     *  Returns a pair of the shared pointer to the decoded value and the
+     *  count of characters consumed from the range.
+     */
+    std::pair<value_ptr_type, size_type>
+    parse(const CharT* __s, size_type __n)
+    {
+        basic_buffer_cursor<CharT, Traits> __c(__s, __n);
+        auto __ptr = decode(__c);
+        return std::make_pair(__ptr, __c.position());
+    }
+
+    /**
+     *  @brief Decode the value from the specified input stream.
+     *  @param __s  Reference to the input stream.
+     */
+    value_ptr_type
+    load(std::basic_istream<CharT, Traits>& __s)
+    {
+        basic_streambuf_cursor<CharT, Traits> __c(__s);
+        return decode(__c);
+    }
+
+private:
+    template <typename Cursor>
+    void
+    _M_push(Cursor& __c, list_type* __list, dict_type* __dict)
+    {
+        if (_M_size == _M_depth) {
+            std::ostringstream __error;
+
+            __error << "bencode::decoder the nesting depth exceeds "
+                "the limit of " << _M_depth << " at offset "
+                << __c.position() - 1 << "\n";
+            __bencode_throw(value_error(__error.str()));
+        }
+
+        if (_M_size == _M_stack.size()) {
+            _M_stack.emplace_back();
+        }
+
+        auto& __frame = _M_stack[_M_size++];
+        __frame._M_list = __list;
+        __frame._M_dict = __dict;
+        __frame._M_has_key = false;
+    }
+
+    // Add the value to the container on the top of the stack, the
+    // containers are added before their elements are decoded.
+    void
+    _M_attach(const value_ptr_type& __value)
+    {
+        if (!_M_size) {
+            _M_root = __value;
+            return;
+        }
+
+        auto& __top = _M_stack[_M_size - 1];
+        if (__top._M_list) {
+            __top._M_list->insert(__value);
+            return;
+        }
+
+        // The first value of the duplicate key is kept, the same as the
+        // recursive decoder does.
+        __top._M_dict->insert(
+            typename dict_type::value_type(__top._M_key, __value));
+        __top._M_has_key = false;
+    }
+
+    template <typename Cursor>
+    void
+    _M_key(Cursor& __c, __frame& __top)
+    {
+        __top._M_key = string_type();
+        __top._M_key.decode(__c);
+
+        auto __ch = __c.get();
+        if (__ch != basic_value_type::delimiter_token) {
+            std::ostringstream __error;
+
+            __error << "bencode::decoder after the key a `:` "
+                "delimiter expected, but `" << CharT(__ch)
+                << "` found\n";
+            __bencode_throw(encoding_error(__error.str()));
+        }
+        __top._M_has_key = true;
+    }
+
+    // The maximum count of the nested containers.
+    size_type _M_depth;
+
+    // The stack of the frames, only the first `_M_size` are in use.
+    std::vector<__frame> _M_stack;
+    size_type _M_size;
+
+    // The outermost value.
+    value_ptr_type _M_root;
+};
+
+
+typedef basic_decoder<char> decoder;
+
+
+typedef basic_decoder<wchar_t> wdecoder;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_decoder_hpp__
@@ -2,6 +2,7 @@
 #define INCLUDE_bencode_dict_hpp__
 
 #include <utility>
+#include <bencode/cursor.hpp>
 #include <bencode/string.hpp>
 #include <bencode/value.hpp>
 
@@ -44,7 +45,7 @@ private:
     struct lexicographical_compare
     {
         bool
-        operator()(const _T& lhs, const _T& rhs)
+        operator()(const _T& lhs, const _T& rhs) const
         {
             return std::lexicographical_compare(
                 lhs.cbegin(), lhs.cend(),
@@ -105,10 +106,8 @@ public:
      *  @param __value  Reference to the basic type.
      */
     basic_dict(const basic_value_type& __value)
-    {
-        auto __dict = dynamic_cast<const basic_dict&>(__value);
-        _M_container = container_type(__dict._M_container);
-    }
+    : _M_container(dynamic_cast<const basic_dict&>(__value)._M_container)
+    { }
 
     /**
      *  @brief Construct a dictionary using downcasted pointer to the basic type.
@@ -137,9 +136,32 @@ public:
     : _M_container(__first, __last)
     { }
 
+    /**
+     *  @brief Construct a dictionary as a copy of @a dict.
+     *  @param __dict  Source dictionary.
+     */
+    basic_dict(const basic_dict& __dict)
+    : _M_container(__dict._M_container)
+    { }
+
+    /**
+     *  @brief Construct a dictionary with the items of @a dict, the source
+     *         dictionary is left empty.
+     *  @param __dict  Source dictionary.
+     */
+    basic_dict(basic_dict&& __dict) noexcept
+    : _M_container(std::move(__dict._M_container))
+    { }
+
     ~basic_dict()
     { }
 
+    basic_dict&
+    operator=(const basic_dict& __dict) = default;
+
+    basic_dict&
+    operator=(basic_dict&& __dict) = default;
+
     /**
      *  @brief Serialize the dictionary value to the specified output stream.
      *  @param __s  Reference to the output stream.
@@ -172,63 +194,77 @@ public:
     void
     load(std::basic_istream<CharT, Traits> &__s)
     {
-        if (__s.peek() != basic_value_type::dict_token) {
-            throw type_error(
+        basic_streambuf_cursor<CharT, Traits> __c(__s);
+        decode(__c);
+    }
+
+    /**
+     *  @brief Deserialize the dictionary value from the specified cursor.
+     *  @param __c  Reference to the input cursor.
+     */
+    template <typename Cursor>
+    void
+    decode(Cursor& __c)
+    {
+        if (__c.peek() != basic_value_type::dict_token) {
+            __bencode_throw(type_error(
                 "bencode::dict::load the specified stream does not "
-                "contain interpretable bencode dictionary value\n");
+                "contain interpretable bencode dictionary value\n"));
         }
 
-        // Read the "d" symbol from the provided stream.
-        __s.get();
+        // Read the "d" symbol from the provided cursor.
+        __c.get();
 
         // At the next step we are going to decode the items
         // of the Bencoded dictionary.
-        while (!__s.eof() && __s.peek() != basic_value_type::end_token) {
+        auto __ch = __c.peek();
+        while (!Traits::eq_int_type(__ch, Traits::eof())
+                && __ch != basic_value_type::end_token) {
             // Read the key of the next dictionary item.
             key_type __key;
 
-            // Extract the string key from the input stream.
-            __key.load(__s);
+            // Extract the string key from the input cursor.
+            __key.decode(__c);
 
             // Ensure that key is separated from the value
             // with the delimiter token, and throw an error
             // otherwise.
-            if (__s.peek() != basic_value_type::delimiter_token) {
+            if (__c.peek() != basic_value_type::delimiter_token) {
                 std::ostringstream __error;
 
                 __error << "bencode::dict::load after the key a `:` "
-                    "delimiter expected, but `" << CharT(__s.peek())
+                    "delimiter expected, but `" << CharT(__c.peek())
                     << "` found\n";
-                throw encoding_error(__error.str());
+                __bencode_throw(encoding_error(__error.str()));
             }
 
             // Extract the delimiter symbol from the input
-            // stream.
-            __s.get();
+            // cursor.
+            __c.get();
 
             // Decode the value of the dictionary item.
-            auto __value = make_value<__bencode_dict_typenames>(__s);
+            auto __value = decode_value<__bencode_dict_typenames>(__c);
 
             // Insert a new element into the dictionary.
-            _M_container.insert(value_type(__key, __value));
+            _M_container.emplace(std::move(__key), std::move(__value));
 
-            // Force read the next symbols from the input stream.
-            __s.peek();
+            // Look at the next symbol of the cursor.
+            __ch = __c.peek();
         }
 
         // Ensure that all those operations where not performed
-        // for nothing, and check that the stream is pointing to
+        // for nothing, and check that the cursor is pointing to
         // the end token.
-        if (__s.peek() != basic_value_type::end_token) {
+        if (__ch != basic_value_type::end_token) {
             std::ostringstream __error;
 
             __error << "bencode::dict::load the end of the dictionary "
-                "`e` expected, but `" << CharT(__s.peek()) << "` found\n";
-            throw encoding_error(__error.str());
+                "`e` expected, but `" << CharT(__ch) << "` found\n";
+            __bencode_throw(encoding_error(__error.str()));
         }
 
-        // Read the "e" symbol from the input stream.
-        __s.get();
+        // Read the "e" symbol from the input cursor.
+        __c.get();
     }
 
     /**
@@ -290,6 +326,15 @@ public:
     insert(const value_type& __value)
     { return _M_container.insert(__value); }
 
+    /**
+     *  @brief Move element into the container, if the container does not
+     *         already contain an element with an equivalent key.
+     *  @param __value  Element value to insert.
+     */
+    std::pair<iterator, bool>
+    insert(value_type&& __value)
+    { return _M_container.insert(std::move(__value)); }
+
     /**
      *  @brief Removes the specified element from the container.
      *  @param __pos  Mutable iterator to the element to remove.
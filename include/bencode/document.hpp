@@ -0,0 +1,672 @@
+#ifndef INCLUDE_bencode_document_hpp__
+#define INCLUDE_bencode_document_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Type of the document tape entry.
+ */
+enum class tape_type : unsigned char
+{
+    integer = 'i',
+    string = 's',
+    list = 'l',
+    dict = 'd',
+    end = 'e'
+};
+
+
+namespace __detail
+{
+
+
+// The tape entry keeps the type in the highest byte and the payload
+// in the rest of the bits.
+const uint64_t __tape_payload_mask = (uint64_t(1) << 56) - 1;
+
+
+inline uint64_t
+__tape_entry(tape_type __type, uint64_t __payload)
+{ return (uint64_t(__type) << 56) | __payload; }
+
+
+inline tape_type
+__tape_entry_type(uint64_t __entry)
+{ return tape_type(__entry >> 56); }
+
+
+inline uint64_t
+__tape_entry_payload(uint64_t __entry)
+{ return __entry & __tape_payload_mask; }
+
+
+// Handler of the structure walk, which counts the tape entries.
+template <typename CharT, typename IntT>
+struct __tape_counter
+{
+    std::size_t _M_count;
+
+    void integer(const CharT*, IntT)
+    { _M_count += 2; }
+
+    void string(const CharT*, const CharT*, std::size_t)
+    { _M_count += 2; }
+
+    void key(const CharT*, const CharT*, std::size_t)
+    { _M_count += 2; }
+
+    void begin_list(const CharT*)
+    { _M_count += 1; }
+
+    void end_list(const CharT*)
+    { _M_count += 1; }
+
+    void begin_dict(const CharT*)
+    { _M_count += 1; }
+
+    void end_dict(const CharT*)
+    { _M_count += 1; }
+};
+
+
+// Handler of the structure walk, which writes the tape entries.
+//
+// Until the container is closed, its entry keeps the index of the
+// enclosing open container, so the open containers are linked through
+// the tape itself and no separate stack is required. On close the
+// entry is replaced with the index right past the end entry.
+template <typename CharT, typename IntT>
+struct __tape_builder
+{
+    const CharT* _M_first;
+    std::vector<uint64_t>& _M_tape;
+    uint64_t _M_open;
+
+    void integer(const CharT*, IntT __value)
+    {
+        _M_tape.push_back(__tape_entry(tape_type::integer, 0));
+        _M_tape.push_back(uint64_t(__value));
+    }
+
+    void string(const CharT*, const CharT* __s, std::size_t __n)
+    {
+        _M_tape.push_back(__tape_entry(tape_type::string,
+            uint64_t(__s - _M_first)));
+        _M_tape.push_back(uint64_t(__n));
+    }
+
+    void key(const CharT* __token, const CharT* __s, std::size_t __n)
+    { string(__token, __s, __n); }
+
+    void begin_list(const CharT*)
+    { begin(tape_type::list); }
+
+    void end_list(const CharT*)
+    { end(); }
+
+    void begin_dict(const CharT*)
+    { begin(tape_type::dict); }
+
+    void end_dict(const CharT*)
+    { end(); }
+
+    void begin(tape_type __type)
+    {
+        auto __index = uint64_t(_M_tape.size());
+        _M_tape.push_back(__tape_entry(__type, _M_open));
+        _M_open = __index;
+    }
+
+    void end()
+    {
+        auto __open = _M_open;
+        auto& __entry = _M_tape[std::size_t(__open)];
+
+        _M_open = __tape_entry_payload(__entry);
+        _M_tape.push_back(__tape_entry(tape_type::end, __open));
+
+        __entry = __tape_entry(__tape_entry_type(__entry),
+            uint64_t(_M_tape.size()));
+    }
+};
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Template class basic_document_value.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  Read-only reference to the value stored on the document tape. The
+ *  reference is valid as long as the document it belongs to.
+ */
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> class basic_document_value
+{
+public:
+    /**
+     *  @brief Internal integer type.
+     */
+    using integer_type = IntT;
+
+    /**
+     *  @brief String type returned on copy of string values.
+     */
+    using string_type = std::basic_string<CharT, Traits>;
+
+    /**
+     *  @brief Unsigned integral type of the container size.
+     */
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Template class const_iterator.
+     *
+     *  Forward iterator over the elements of the list or the values of
+     *  the dictionary.
+     */
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = basic_document_value;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = const basic_document_value*;
+
+        using reference = basic_document_value;
+
+        const_iterator(const basic_document_value& __value, bool __dict)
+        : _M_value(__value), _M_dict(__dict)
+        { }
+
+        /**
+         *  @brief Returns the current element of the list or the value
+         *         of the current dictionary item.
+         */
+        basic_document_value
+        operator*() const
+        { return _M_dict ? _M_value._M_at(_M_value._M_end()) : _M_value; }
+
+        /**
+         *  @brief Returns the key of the current dictionary item.
+         */
+        basic_document_value
+        key() const
+        { return _M_value; }
+
+        const_iterator&
+        operator++()
+        {
+            auto __next = _M_value._M_at(_M_value._M_end());
+            if (_M_dict) {
+                __next = __next._M_at(__next._M_end());
+            }
+
+            _M_value = __next;
+            return *this;
+        }
+
+        const_iterator
+        operator++(int)
+        { auto __it = *this; ++*this; return __it; }
+
+        bool
+        operator==(const const_iterator& __it) const
+        { return _M_value._M_index == __it._M_value._M_index; }
+
+        bool
+        operator!=(const const_iterator& __it) const
+        { return !(*this == __it); }
+
+    private:
+        // For lists the value is the element itself, for dictionaries
+        // it is the key of the item.
+        basic_document_value _M_value;
+        bool _M_dict;
+    };
+
+    /**
+     *  @brief Construct the reference to the tape entry.
+     *  @param __tape    Pointer to the first entry of the tape.
+     *  @param __source  Pointer to the source symbols of the document.
+     *  @param __index   Index of the referenced entry.
+     */
+    basic_document_value(const uint64_t* __tape, const CharT* __source,
+        std::size_t __index)
+    : _M_tape(__tape), _M_source(__source), _M_index(__index)
+    { }
+
+    /**
+     *  @brief Returns the type of the value.
+     */
+    tape_type
+    type() const
+    { return __detail::__tape_entry_type(_M_entry()); }
+
+    /**
+     *  @brief Returns the integer value.
+     *
+     *  Throws `type_error` when the value is not an integer.
+     */
+    integer_type
+    integer() const
+    {
+        _M_check(tape_type::integer, "integer");
+        return integer_type(_M_tape[_M_index+1]);
+    }
+
+    /**
+     *  @brief Returns the pointer to the symbols of the string value.
+     *
+     *  The symbols are not null-terminated. Throws `type_error` when
+     *  the value is not a string.
+     */
+    const CharT*
+    data() const
+    {
+        _M_check(tape_type::string, "string");
+        return _M_source + __detail::__tape_entry_payload(_M_entry());
+    }
+
+    /**
+     *  @brief Returns the count of symbols of the string value.
+     *
+     *  Throws `type_error` when the value is not a string.
+     */
+    size_type
+    length() const
+    {
+        _M_check(tape_type::string, "string");
+        return size_type(_M_tape[_M_index+1]);
+    }
+
+    /**
+     *  @brief Returns the copy of the string value.
+     *
+     *  Throws `type_error` when the value is not a string.
+     */
+    string_type
+    string() const
+    { return string_type(data(), length()); }
+
+    /**
+     *  @brief Returns the count of elements in the list or items
+     *         in the dictionary.
+     *
+     *  The elements are counted by skipping over them, so the operation
+     *  is linear to the count of elements.
+     */
+    size_type
+    size() const
+    { return size_type(std::distance(begin(), end())); }
+
+    /**
+     *  @brief Returns the iterator to the first element of the list or
+     *         the first item of the dictionary.
+     */
+    const_iterator
+    begin() const
+    {
+        _M_check_container();
+        return const_iterator(_M_at(_M_index+1),
+            type() == tape_type::dict);
+    }
+
+    /**
+     *  @brief Returns the iterator one past the last element of the list
+     *         or the last item of the dictionary.
+     */
+    const_iterator
+    end() const
+    {
+        _M_check_container();
+        return const_iterator(_M_at(_M_end()-1),
+            type() == tape_type::dict);
+    }
+
+    /**
+     *  @brief Subscript access to the list element.
+     *  @param __index  Position of the element.
+     *
+     *  Throws `value_error` when the index is out of range.
+     */
+    basic_document_value
+    operator[](size_type __index) const
+    {
+        _M_check(tape_type::list, "list");
+
+        auto __first = begin(), __last = end();
+        for (; __index && __first != __last; --__index, ++__first)
+        { }
+
+        if (__first == __last) {
+            __bencode_throw(value_error(
+                "bencode::document_value the index of "
+                "the list element is out of range\n"));
+        }
+        return *__first;
+    }
+
+    /**
+     *  @brief Subscript access to the dictionary value.
+     *  @param __key  Key of the dictionary item.
+     *
+     *  Throws `value_error` when the dictionary does not contain the
+     *  specified key.
+     */
+    basic_document_value
+    operator[](const string_type& __key) const
+    {
+        auto __it = find(__key);
+        if (__it == end()) {
+            __bencode_throw(value_error(
+                "bencode::document_value the dictionary "
+                "does not contain the specified key\n"));
+        }
+        return *__it;
+    }
+
+    /**
+     *  @brief Find the item of the dictionary.
+     *  @param __key  Key of the dictionary item.
+     *
+     *  Returns the iterator to the item, or `end()` when the dictionary
+     *  does not contain the specified key.
+     */
+    const_iterator
+    find(const string_type& __key) const
+    {
+        _M_check(tape_type::dict, "dict");
+
+        auto __first = begin(), __last = end();
+        for (; __first != __last; ++__first) {
+            auto __k = __first.key();
+            if (__k.length() == __key.size() &&
+                    !Traits::compare(__k.data(), __key.data(), __key.size())) {
+                break;
+            }
+        }
+        return __first;
+    }
+
+private:
+    uint64_t
+    _M_entry() const
+    { return _M_tape[_M_index]; }
+
+    // Returns the index of the entry right past the value.
+    std::size_t
+    _M_end() const
+    {
+        switch (type()) {
+        case tape_type::list:
+        case tape_type::dict:
+            return std::size_t(__detail::__tape_entry_payload(_M_entry()));
+        case tape_type::end:
+            return _M_index + 1;
+        default:
+            return _M_index + 2;
+        }
+    }
+
+    // Returns the reference to the entry of the same tape.
+    basic_document_value
+    _M_at(std::size_t __index) const
+    { return basic_document_value(_M_tape, _M_source, __index); }
+
+    void
+    _M_check(tape_type __type, const char* __name) const
+    {
+        if (type() != __type) {
+            __bencode_throw(type_error(std::string(
+                "bencode::document_value the value is not a ") +
+                __name + "\n"));
+        }
+    }
+
+    void
+    _M_check_container() const
+    {
+        if (type() != tape_type::list && type() != tape_type::dict) {
+            __bencode_throw(type_error(
+                "bencode::document_value the value is "
+                "not a container\n"));
+        }
+    }
+
+    const uint64_t* _M_tape;
+    const CharT* _M_source;
+    std::size_t _M_index;
+};
+
+
+/**
+ *  @brief Template class basic_document.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  The decoded bencode value stored as a contiguous tape of tagged
+ *  64-bit entries. Integers occupy two entries: the tag and the value.
+ *  Strings occupy two entries as well: the tag with the offset of the
+ *  payload in the source symbols and the length of the payload. Lists
+ *  and dictionaries are enclosed into the opening entry, which keeps
+ *  the index right past the container, and the end entry, so children
+ *  could be skipped in a constant time.
+ *
+ *  The document shares the ownership of the encoded value and owns the
+ *  tape, so it is decoded with a constant count of memory allocations.
+ */
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> class basic_document
+{
+    static_assert(sizeof(IntT) <= sizeof(uint64_t),
+        "integer type should fit into the tape entry");
+
+public:
+    /**
+     *  @brief Reference to the value of the document.
+     */
+    using value_type = basic_document_value<CharT, IntT, Traits>;
+
+    /**
+     *  @brief Type of the source symbols of the document.
+     */
+    using string_type = std::basic_string<CharT, Traits>;
+
+    /**
+     *  @brief Type of the document tape.
+     */
+    using tape_container = std::vector<uint64_t>;
+
+    /**
+     *  @brief Construct an empty document.
+     */
+    basic_document()
+    { }
+
+    /**
+     *  @brief Construct a document from the range of characters.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     */
+    basic_document(const CharT* __s, std::size_t __n)
+    { parse(__s, __n); }
+
+    /**
+     *  @brief Construct a document from the string of characters.
+     *  @param __str  Source string.
+     */
+    explicit
+    basic_document(const string_type& __str)
+    { parse(__str.data(), __str.size()); }
+
+    /**
+     *  @brief Decode the first value of the range into the document.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     *
+     *  The document keeps the copy of the consumed characters. Throws
+     *  `encoding_error` when the value is malformed, the document is not
+     *  modified in this case. Returns the count of consumed characters.
+     */
+    std::size_t
+    parse(const CharT* __s, std::size_t __n)
+    {
+        // At first, validate the value and count the tape entries, so
+        // the tape and the source are allocated exactly once.
+        __detail::__tape_counter<CharT, IntT> __counter{0};
+        auto __end = __detail::__walk_structure<CharT, IntT, Traits>(
+            __s, __s + __n, __counter, "bencode::document");
+
+        auto __source = std::make_shared<string_type>(__s, __end);
+        _M_build(__source, __source->data(), __source->size(),
+            __counter._M_count);
+        return _M_size;
+    }
+
+    /**
+     *  @brief Decode the first value of the range into the document
+     *         without copying the range.
+     *  @param __owner  Owner of the memory of the range.
+     *  @param __s      Start of the range.
+     *  @param __n      Count of characters in the range.
+     *
+     *  The strings of the document refer to the range, which is kept
+     *  alive by the document through the shared @a __owner. Throws
+     *  `encoding_error` when the value is malformed, the document is not
+     *  modified in this case. Returns the count of consumed characters.
+     */
+    std::size_t
+    parse(const std::shared_ptr<const void>& __owner, const CharT* __s,
+        std::size_t __n)
+    {
+        __detail::__tape_counter<CharT, IntT> __counter{0};
+        auto __end = __detail::__walk_structure<CharT, IntT, Traits>(
+            __s, __s + __n, __counter, "bencode::document");
+
+        _M_build(__owner, __s, std::size_t(__end - __s), __counter._M_count);
+        return _M_size;
+    }
+
+    /**
+     *  @brief Returns the reference to the root value.
+     *
+     *  Throws `value_error` when the document is empty.
+     */
+    value_type
+    root() const
+    {
+        if (_M_tape.empty()) {
+            __bencode_throw(value_error("bencode::document::root the "
+                "document is empty\n"));
+        }
+        return value_type(_M_tape.data(), _M_data, 0);
+    }
+
+    /**
+     *  @brief Returns the copy of the encoded symbols of the document.
+     */
+    string_type
+    source() const
+    { return string_type(_M_data, _M_size); }
+
+    /**
+     *  @brief Returns the pointer to the encoded symbols of the document.
+     */
+    const CharT*
+    data() const
+    { return _M_data; }
+
+    /**
+     *  @brief Returns the count of the encoded symbols of the document.
+     */
+    std::size_t
+    size() const
+    { return _M_size; }
+
+    /**
+     *  @brief Returns the tape of the document.
+     */
+    const tape_container&
+    tape() const
+    { return _M_tape; }
+
+    /**
+     *  @brief Check whether the document is empty.
+     */
+    bool
+    empty() const
+    { return _M_tape.empty(); }
+
+private:
+    // Build the tape over the validated value.
+    void
+    _M_build(const std::shared_ptr<const void>& __owner, const CharT* __s,
+        std::size_t __n, std::size_t __count)
+    {
+        tape_container __tape;
+        __tape.reserve(__count);
+
+        __detail::__tape_builder<CharT, IntT> __builder{__s, __tape, 0};
+        __detail::__walk_structure<CharT, IntT, Traits>(
+            __s, __s + __n, __builder, "bencode::document");
+
+        _M_owner = __owner;
+        _M_data = __s;
+        _M_size = __n;
+        _M_tape.swap(__tape);
+    }
+
+    // The owner of the encoded symbols, which are referred by the tape.
+    std::shared_ptr<const void> _M_owner;
+    const CharT* _M_data = nullptr;
+    std::size_t _M_size = 0;
+
+    tape_container _M_tape;
+};
+
+
+typedef basic_document<char> document;
+
+
+typedef basic_document<wchar_t> wdocument;
+
+
+typedef basic_document_value<char> document_value;
+
+
+typedef basic_document_value<wchar_t> wdocument_value;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_document_hpp__
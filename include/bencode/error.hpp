@@ -0,0 +1,136 @@
+#ifndef INCLUDE_bencode_error_hpp__
+#define INCLUDE_bencode_error_hpp__
+
+#include <string>
+#include <system_error>
+#include <type_traits>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Kinds of the errors of the malformed values.
+ */
+enum class errc
+{
+    // The value is well-formed.
+    success = 0,
+    // The input ends before the value is complete.
+    unexpected_end,
+    // The symbol could not start a value at this position.
+    unexpected_token,
+    // The integer contains non-digit symbols or no digits at all.
+    invalid_integer,
+    // The integer or the string length has a redundant leading zero.
+    leading_zero,
+    // The integer is negative zero (i.e. "i-0e").
+    negative_zero,
+    // The integer does not fit into the target integer type.
+    integer_overflow,
+    // The string length is not a non-negative number.
+    invalid_length,
+    // The delimiter `:` is missing after the string length or the key.
+    missing_delimiter,
+    // The key of the dictionary is not a string.
+    invalid_key,
+    // The nesting of the containers is deeper than allowed.
+    depth_exceeded,
+    // The input contains symbols after the value.
+    trailing_data,
+    // The keys of the dictionary are not sorted by their raw bytes.
+    unsorted_keys,
+    // The key is repeated in the dictionary.
+    duplicate_key
+};
+
+
+namespace __detail
+{
+
+
+class __error_category : public std::error_category
+{
+public:
+    const char*
+    name() const noexcept
+    { return "bencode"; }
+
+    std::string
+    message(int __ev) const
+    {
+        switch (static_cast<errc>(__ev))
+        {
+        case errc::success:
+            return "success";
+        case errc::unexpected_end:
+            return "unexpected end of the value";
+        case errc::unexpected_token:
+            return "unexpected symbol";
+        case errc::invalid_integer:
+            return "invalid integer";
+        case errc::leading_zero:
+            return "redundant leading zero";
+        case errc::negative_zero:
+            return "negative zero";
+        case errc::integer_overflow:
+            return "integer is out of range";
+        case errc::invalid_length:
+            return "invalid string length";
+        case errc::missing_delimiter:
+            return "the delimiter `:` expected";
+        case errc::invalid_key:
+            return "the key of the dictionary is not a string";
+        case errc::depth_exceeded:
+            return "the nesting depth exceeds the limit";
+        case errc::trailing_data:
+            return "unexpected symbols after the value";
+        case errc::unsorted_keys:
+            return "the keys of the dictionary are not sorted";
+        case errc::duplicate_key:
+            return "the key of the dictionary is duplicated";
+        }
+        return "unknown error";
+    }
+};
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Returns the category of the bencode errors.
+ */
+inline const std::error_category&
+error_category() noexcept
+{
+    static const __detail::__error_category __category;
+    return __category;
+}
+
+
+/**
+ *  @brief Create the error code of the bencode error kind.
+ *  @param __e  Kind of the error.
+ */
+inline std::error_code
+make_error_code(errc __e) noexcept
+{ return std::error_code(static_cast<int>(__e), error_category()); }
+
+
+} // namespace bencode
+
+
+namespace std
+{
+
+
+template <>
+struct is_error_code_enum<bencode::errc> : true_type
+{ };
+
+
+} // namespace std
+
+#endif // INCLUDE_bencode_error_hpp__
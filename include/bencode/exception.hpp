@@ -2,9 +2,20 @@
 #define INCLUDE_bencode_exception_hpp__
 
 
+#include <cstdlib>
 #include <stdexcept>
 
 
+// Throw the exception, or terminate the program, when the exceptions
+// are disabled (e.g. with `-fno-exceptions`). The non-throwing API is
+// usable in such builds, since it never reaches these points.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define __bencode_throw(__e) throw __e
+#else
+#define __bencode_throw(__e) std::abort()
+#endif
+
+
 namespace bencode
 {
 
@@ -0,0 +1,476 @@
+#ifndef INCLUDE_bencode_extract_hpp__
+#define INCLUDE_bencode_extract_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bencode/algorithm.hpp>
+#include <bencode/document.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+#include <bencode/skip.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Template class basic_path_match.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  Define the value matched by the path of the extractor. The match
+ *  refers to the encoded symbols of the value, so it is valid only
+ *  until the extracted buffer is released.
+ */
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> class basic_path_match
+{
+public:
+    using integer_type = IntT;
+
+    using string_type = std::basic_string<CharT, Traits>;
+
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Construct a match of the encoded value.
+     *  @param __path   Index of the matched path.
+     *  @param __first  Start of the encoded value.
+     *  @param __last   End of the encoded value.
+     */
+    basic_path_match(size_type __path, const CharT* __first,
+        const CharT* __last)
+    : _M_path(__path), _M_first(__first), _M_last(__last)
+    { }
+
+    /**
+     *  @brief Returns the index of the matched path in the order of
+     *         registration.
+     */
+    size_type
+    path() const
+    { return _M_path; }
+
+    /**
+     *  @brief Returns the type of the matched value.
+     */
+    tape_type
+    type() const
+    {
+        using basic_value_type = basic_value<CharT, Traits>;
+
+        switch (*_M_first)
+        {
+        case basic_value_type::integer_token:
+            return tape_type::integer;
+        case basic_value_type::list_token:
+            return tape_type::list;
+        case basic_value_type::dict_token:
+            return tape_type::dict;
+        default:
+            return tape_type::string;
+        }
+    }
+
+    /**
+     *  @brief Returns the pointer to the first symbol of the encoded value.
+     */
+    const CharT*
+    first() const
+    { return _M_first; }
+
+    /**
+     *  @brief Returns the pointer past the last symbol of the encoded value.
+     */
+    const CharT*
+    last() const
+    { return _M_last; }
+
+    /**
+     *  @brief Returns the integer value.
+     *
+     *  Throws `type_error` when the value is not an integer.
+     */
+    integer_type
+    integer() const
+    {
+        _M_check(tape_type::integer, "integer");
+
+        integer_type __value = 0;
+        decode_integer(_M_first + 1, _M_last - 1, __value);
+        return __value;
+    }
+
+    /**
+     *  @brief Returns the pointer to the symbols of the string value.
+     *
+     *  The symbols are not null-terminated. Throws `type_error` when
+     *  the value is not a string.
+     */
+    const CharT*
+    data() const
+    { return _M_last - length(); }
+
+    /**
+     *  @brief Returns the count of symbols of the string value.
+     *
+     *  Throws `type_error` when the value is not a string.
+     */
+    size_type
+    length() const
+    {
+        _M_check(tape_type::string, "string");
+
+        auto __delimiter = Traits::find(_M_first, _M_last - _M_first,
+            basic_value<CharT, Traits>::delimiter_token);
+        return size_type(_M_last - __delimiter - 1);
+    }
+
+    /**
+     *  @brief Returns the copy of the string value.
+     *
+     *  Throws `type_error` when the value is not a string.
+     */
+    string_type
+    string() const
+    { return string_type(data(), length()); }
+
+private:
+    void
+    _M_check(tape_type __type, const char* __name) const
+    {
+        if (type() != __type) {
+            __bencode_throw(type_error(std::string("bencode::path_match the "
+                "value is not a ") + __name + "\n"));
+        }
+    }
+
+    size_type _M_path;
+    const CharT* _M_first;
+    const CharT* _M_last;
+};
+
+
+/**
+ *  @brief Template class basic_extractor.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  Extract the values located by the set of paths in a single pass
+ *  over the encoded buffer without decoding it into the tree of values.
+ *  The segments of the path are separated by the `/` symbol. A segment
+ *  matches the dictionary key equal to it or the list element with the
+ *  index equal to it, the `*` segment matches any key or element. The
+ *  subtrees, which could not match any path, are skipped.
+ */
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> class basic_extractor
+{
+public:
+    using string_type = std::basic_string<CharT, Traits>;
+
+    using match_type = basic_path_match<CharT, IntT, Traits>;
+
+    using callback_type = std::function<void(const match_type&)>;
+
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Register the path with the callback.
+     *  @param __path      Path to the extracted values.
+     *  @param __callback  Callback called for every matched value.
+     *
+     *  The callbacks are called in the order of the ends of the matched
+     *  values, so a container is reported after the values nested into
+     *  it. Returns the index of the path.
+     */
+    size_type
+    on(const string_type& __path, callback_type __callback)
+    {
+        _M_paths.push_back(_M_split(__path));
+        _M_paths.back()._M_callback = std::move(__callback);
+        return _M_paths.size() - 1;
+    }
+
+    /**
+     *  @brief Register the path to the integer value.
+     *  @param __path   Path to the extracted value.
+     *  @param __value  Reference to the integer to store the value.
+     *
+     *  Throws `type_error` on extraction, when the matched value is not
+     *  an integer. Returns the index of the path.
+     */
+    size_type
+    bind(const string_type& __path, IntT& __value)
+    {
+        return on(__path, [&__value](const match_type& __match) {
+            __value = __match.integer();
+        });
+    }
+
+    /**
+     *  @brief Register the path to the string value.
+     *  @param __path   Path to the extracted value.
+     *  @param __value  Reference to the string to store the value.
+     *
+     *  Throws `type_error` on extraction, when the matched value is not
+     *  a string. Returns the index of the path.
+     */
+    size_type
+    bind(const string_type& __path, string_type& __value)
+    {
+        return on(__path, [&__value](const match_type& __match) {
+            __value.assign(__match.data(), __match.length());
+        });
+    }
+
+    /**
+     *  @brief Extract the values from the first value in the range.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     *
+     *  Throws `encoding_error` on the first invalid symbol. Returns the
+     *  count of characters of the walked value.
+     */
+    size_type
+    extract(const CharT* __s, size_type __n)
+    {
+        for (auto& __path : _M_paths) {
+            __path._M_depth = 0;
+        }
+
+        auto __end = _M_value(__s, __s, __s + __n, 0);
+        return size_type(__end - __s);
+    }
+
+    /**
+     *  @brief Extract the values from the first value in the string.
+     *  @param __s  Encoded string.
+     */
+    size_type
+    extract(const string_type& __s)
+    { return extract(__s.data(), __s.size()); }
+
+private:
+    // Segment of the path, which is either a dictionary key, an index
+    // of the list element or a wildcard.
+    struct __segment
+    {
+        string_type _M_key;
+        size_type _M_index;
+        bool _M_any;
+
+        bool
+        match(const CharT* __key, size_type __length, size_type __index) const
+        {
+            if (_M_any) {
+                return true;
+            }
+            if (__key != nullptr) {
+                return _M_key.size() == __length &&
+                    !Traits::compare(_M_key.data(), __key, __length);
+            }
+            return _M_index == __index;
+        }
+    };
+
+    // Registered path with the depth, which was matched so far.
+    struct __path
+    {
+        std::vector<__segment> _M_segments;
+        callback_type _M_callback;
+        size_type _M_depth;
+    };
+
+    static __path
+    _M_split(const string_type& __s)
+    {
+        __path __p;
+        __p._M_depth = 0;
+
+        if (__s.empty()) {
+            return __p;
+        }
+
+        size_type __first = 0;
+        for (;;) {
+            auto __last = __s.find(CharT('/'), __first);
+            if (__last == string_type::npos) {
+                __last = __s.size();
+            }
+
+            __segment __seg;
+            __seg._M_key = __s.substr(__first, __last - __first);
+            __seg._M_any = __seg._M_key.size() == 1 &&
+                __seg._M_key[0] == CharT('*');
+
+            // Segments of digits could be used as list indices.
+            uint64_t __index = 0;
+            __seg._M_index = decode_integer(__seg._M_key.data(),
+                __seg._M_key.data() + __seg._M_key.size(), __index) ==
+                integer_errc::success ? size_type(__index) : size_type(-1);
+
+            __p._M_segments.push_back(std::move(__seg));
+            if (__last == __s.size()) {
+                return __p;
+            }
+            __first = __last + 1;
+        }
+    }
+
+    // Walk over the value, descend into it when any path continues
+    // at the nested values and report the completed paths.
+    const CharT*
+    _M_value(const CharT* __begin, const CharT* __p, const CharT* __last,
+        size_type __depth)
+    {
+        using basic_value_type = basic_value<CharT, Traits>;
+
+        bool __descend = false;
+        for (auto& __path : _M_paths) {
+            if (__path._M_depth == __depth &&
+                    __path._M_segments.size() > __depth) {
+                __descend = true;
+            }
+        }
+
+        const CharT* __end;
+        if (__p == __last) {
+            __detail::__throw_structure_error("bencode::extractor",
+                "unexpected end of the value", __begin, __p);
+        } else if (__descend && *__p == basic_value_type::list_token) {
+            __end = _M_list(__begin, __p, __last, __depth);
+        } else if (__descend && *__p == basic_value_type::dict_token) {
+            __end = _M_dict(__begin, __p, __last, __depth);
+        } else {
+            // Nothing could match inside of the value, so it is jumped
+            // over without looking at the nested values.
+            __detail::__skip_handler<CharT, IntT> __handler;
+            __end = __detail::__walk_structure<CharT, IntT, Traits>(
+                __begin, __p, __last, __handler, "bencode::extractor");
+        }
+
+        for (size_type __i = 0; __i < _M_paths.size(); ++__i) {
+            auto& __path = _M_paths[__i];
+            if (__path._M_depth == __depth &&
+                    __path._M_segments.size() == __depth) {
+                __path._M_callback(match_type(__i, __p, __end));
+            }
+        }
+        return __end;
+    }
+
+    // Advance the paths matching the key or the index of the nested
+    // value and walk over it.
+    const CharT*
+    _M_child(const CharT* __begin, const CharT* __p, const CharT* __last,
+        size_type __depth, const CharT* __key, size_type __length,
+        size_type __index)
+    {
+        for (auto& __path : _M_paths) {
+            if (__path._M_depth == __depth &&
+                    __path._M_segments.size() > __depth &&
+                    __path._M_segments[__depth].match(
+                        __key, __length, __index)) {
+                __path._M_depth = __depth + 1;
+            }
+        }
+
+        auto __end = _M_value(__begin, __p, __last, __depth + 1);
+
+        for (auto& __path : _M_paths) {
+            if (__path._M_depth == __depth + 1) {
+                __path._M_depth = __depth;
+            }
+        }
+        return __end;
+    }
+
+    const CharT*
+    _M_list(const CharT* __begin, const CharT* __p, const CharT* __last,
+        size_type __depth)
+    {
+        using basic_value_type = basic_value<CharT, Traits>;
+
+        ++__p;
+        for (size_type __index = 0; ; ++__index) {
+            if (__p == __last) {
+                __detail::__throw_structure_error("bencode::extractor",
+                    "unexpected end of the value", __begin, __p);
+            }
+            if (*__p == basic_value_type::end_token) {
+                return __p + 1;
+            }
+            __p = _M_child(__begin, __p, __last, __depth,
+                nullptr, 0, __index);
+        }
+    }
+
+    const CharT*
+    _M_dict(const CharT* __begin, const CharT* __p, const CharT* __last,
+        size_type __depth)
+    {
+        using basic_value_type = basic_value<CharT, Traits>;
+
+        ++__p;
+        for (;;) {
+            if (__p == __last) {
+                __detail::__throw_structure_error("bencode::extractor",
+                    "unexpected end of the value", __begin, __p);
+            }
+            if (*__p == basic_value_type::end_token) {
+                return __p + 1;
+            }
+
+            std::size_t __length;
+            __p = __detail::__scan_string<CharT, Traits>(
+                __begin, __p, __last, __length, "bencode::extractor");
+
+            if (__p == __last || *__p != basic_value_type::delimiter_token) {
+                __detail::__throw_structure_error("bencode::extractor",
+                    "after the key a `:` delimiter expected", __begin, __p);
+            }
+
+            auto __key = __p - __length;
+            __p = _M_child(__begin, __p + 1, __last, __depth,
+                __key, __length, 0);
+        }
+    }
+
+    // The registered paths.
+    std::vector<__path> _M_paths;
+};
+
+
+typedef basic_path_match<char> path_match;
+
+
+typedef basic_path_match<wchar_t> wpath_match;
+
+
+typedef basic_extractor<char> extractor;
+
+
+typedef basic_extractor<wchar_t> wextractor;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_extract_hpp__
@@ -0,0 +1,219 @@
+#ifndef INCLUDE_bencode_generator_hpp__
+#define INCLUDE_bencode_generator_hpp__
+
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <memory>
+#include <bencode/cursor.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/string.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Template class basic_list_generator.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam Cursor         Input cursor type, defaults to the buffer cursor.
+ *
+ *  Generate the elements of the list one by one as they are decoded,
+ *  so only the current element is kept in memory. The generation could
+ *  be stopped at any moment, the rest of the list is left unread.
+ */
+template
+< __bencode_dict_template
+, typename Cursor = basic_buffer_cursor<CharT, Traits>
+> class basic_list_generator
+{
+private:
+    using basic_value_type = basic_value<CharT, Traits>;
+
+public:
+    using cursor_type = Cursor;
+
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Template class iterator.
+     *
+     *  Input iterator over the generated elements.
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::input_iterator_tag;
+
+        using value_type = value_ptr_type;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = const value_ptr_type*;
+
+        using reference = const value_ptr_type&;
+
+        iterator(basic_list_generator* __gen = nullptr)
+        : _M_gen(__gen)
+        {
+            if (_M_gen) {
+                ++*this;
+            }
+        }
+
+        reference
+        operator*() const
+        { return _M_value; }
+
+        pointer
+        operator->() const
+        { return &_M_value; }
+
+        iterator&
+        operator++()
+        {
+            _M_value = _M_gen->next();
+            if (!_M_value) {
+                _M_gen = nullptr;
+            }
+            return *this;
+        }
+
+        bool
+        operator==(const iterator& __it) const
+        { return _M_gen == __it._M_gen; }
+
+        bool
+        operator!=(const iterator& __it) const
+        { return _M_gen != __it._M_gen; }
+
+    private:
+        basic_list_generator* _M_gen;
+        value_ptr_type _M_value;
+    };
+
+    /**
+     *  @brief Construct a generator over the list in the range.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     */
+    basic_list_generator(const CharT* __s, size_type __n)
+    : _M_cursor(__s, __n), _M_done(false)
+    { _M_begin(); }
+
+    /**
+     *  @brief Construct a generator over the list in the input stream.
+     *  @param __s  Source input stream.
+     */
+    explicit
+    basic_list_generator(std::basic_istream<CharT, Traits>& __s)
+    : _M_cursor(__s), _M_done(false)
+    { _M_begin(); }
+
+    /**
+     *  @brief Decode the next element of the list.
+     *
+     *  Returns `nullptr` when the end of the list is reached.
+     */
+    value_ptr_type
+    next()
+    {
+        if (_M_done) {
+            return nullptr;
+        }
+
+        auto __ch = _M_cursor.peek();
+        if (__ch == basic_value_type::end_token) {
+            _M_cursor.get();
+            _M_done = true;
+            return nullptr;
+        }
+        if (Traits::eq_int_type(__ch, Traits::eof())) {
+            __bencode_throw(encoding_error(
+                "bencode::list_generator the end of the list `e` "
+                "expected, but the end of the stream found\n"));
+        }
+
+        return decode_value<__bencode_dict_typenames>(_M_cursor);
+    }
+
+    /**
+     *  @brief Iterator to the next element.
+     *
+     *  The elements are generated once, so the generator could be
+     *  iterated only once.
+     */
+    iterator
+    begin()
+    { return iterator(this); }
+
+    /**
+     *  @brief Iterator past the last element.
+     */
+    iterator
+    end()
+    { return iterator(); }
+
+    /**
+     *  @brief Returns True when the end of the list is reached.
+     */
+    bool
+    done() const
+    { return _M_done; }
+
+    /**
+     *  @brief Returns the count of characters read so far.
+     */
+    size_type
+    position() const
+    { return _M_cursor.position(); }
+
+private:
+    void
+    _M_begin()
+    {
+        if (_M_cursor.get() != basic_value_type::list_token) {
+            __bencode_throw(type_error(
+                "bencode::list_generator the specified stream "
+                "does not contain interpretable bencode list value\n"));
+        }
+    }
+
+    cursor_type _M_cursor;
+    bool _M_done;
+};
+
+
+typedef basic_list_generator<char> list_generator;
+
+
+typedef basic_list_generator<wchar_t> wlist_generator;
+
+
+typedef basic_list_generator<char, int64_t, std::char_traits<char>,
+    std::allocator, std::map, std::vector, streambuf_cursor>
+    stream_list_generator;
+
+
+typedef basic_list_generator<wchar_t, int64_t, std::char_traits<wchar_t>,
+    std::allocator, std::map, std::vector, wstreambuf_cursor>
+    wstream_list_generator;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_generator_hpp__
@@ -0,0 +1,389 @@
+#ifndef INCLUDE_bencode_index_hpp__
+#define INCLUDE_bencode_index_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <bencode/algorithm.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+namespace __detail
+{
+
+
+// Throw the encoding error pointing to the specified offset, the error
+// is prefixed with the name of the calling function.
+template <typename CharT>
+[[noreturn]] void
+__throw_structure_error(const char* __where, const char* __what,
+    const CharT* __first, const CharT* __pos)
+{
+    std::ostringstream __error;
+
+    __error << __where << " " << __what << " at offset "
+        << (__pos - __first) << "\n";
+    __bencode_throw(encoding_error(__error.str()));
+}
+
+
+// Find the end of the integer symbols started at the specified position,
+// the count of symbols is limited to the maximum length of the integer.
+template <typename CharT, typename Traits>
+const CharT*
+__find_integer_end(const CharT* __first, const CharT* __last)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    auto __limit = __first + basic_value_type::integer_length;
+    if (__last - __first < basic_value_type::integer_length) {
+        __limit = __last;
+    }
+
+    for (; __first != __limit; ++__first) {
+        auto __ch = *__first;
+        if (!(__ch == CharT('-') ||
+                (__ch >= CharT('0') && __ch <= CharT('9')))) {
+            break;
+        }
+    }
+    return __first;
+}
+
+
+// Scan the string token at the specified position and return the
+// pointer right past its payload.
+template <typename CharT, typename Traits>
+const CharT*
+__scan_string(const CharT* __begin, const CharT* __first,
+    const CharT* __last, std::size_t& __length, const char* __where)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    auto __end = __find_integer_end<CharT, Traits>(__first, __last);
+    if (__end == __last) {
+        __throw_structure_error(__where,
+            "unexpected end of the string length", __begin, __end);
+    }
+    if (*__end != basic_value_type::delimiter_token) {
+        __throw_structure_error(__where, "the delimiter `:` expected",
+            __begin, __end);
+    }
+
+    int64_t __count = 0;
+    if (decode_integer(__first, __end, __count) != integer_errc::success
+            || __count < 0) {
+        __throw_structure_error(__where, "invalid string length",
+            __begin, __first);
+    }
+
+    // Jump over the payload of the string without looking at it.
+    ++__end;
+    if (uint64_t(__count) > uint64_t(__last - __end)) {
+        __throw_structure_error(__where, "unexpected end of the string",
+            __begin, __last);
+    }
+
+    __length = std::size_t(__count);
+    return __end + __length;
+}
+
+
+// Scan the integer token at the specified position and return the
+// pointer right past its end token.
+template <typename CharT, typename IntT, typename Traits>
+const CharT*
+__scan_integer(const CharT* __begin, const CharT* __first,
+    const CharT* __last, IntT& __value, const char* __where)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    // Skip the leading "i" symbol.
+    auto __digits = ++__first;
+    auto __end = __find_integer_end<CharT, Traits>(__digits, __last);
+    if (__end == __last) {
+        __throw_structure_error(__where, "unexpected end of the integer",
+            __begin, __end);
+    }
+    if (*__end != basic_value_type::end_token) {
+        __throw_structure_error(__where,
+            "the end of the integer `e` expected", __begin, __end);
+    }
+
+    if (decode_integer(__digits, __end, __value) != integer_errc::success) {
+        __throw_structure_error(__where, "invalid integer",
+            __begin, __digits);
+    }
+    return __end + 1;
+}
+
+
+// Stack of the scopes of opened containers. The first levels of the
+// nesting are kept inline, so the usual documents are walked without
+// any memory allocation.
+class __scope_stack
+{
+public:
+    // The kind of the opened container, dictionaries additionally
+    // track whether the key or the value is expected.
+    enum scope : unsigned char { list, dict_key, dict_value };
+
+    __scope_stack()
+    : _M_size(0), _M_inline()
+    { }
+
+    bool
+    empty() const
+    { return !_M_size; }
+
+    std::size_t
+    size() const
+    { return _M_size; }
+
+    scope&
+    back()
+    { return _M_size <= _S_inline ? _M_inline[_M_size-1] :
+        _M_outline[_M_size-_S_inline-1]; }
+
+    void
+    push(scope __s)
+    {
+        if (_M_size < _S_inline) {
+            _M_inline[_M_size] = __s;
+        } else {
+            _M_outline.push_back(__s);
+        }
+        ++_M_size;
+    }
+
+    void
+    pop()
+    {
+        if (_M_size > _S_inline) {
+            _M_outline.pop_back();
+        }
+        --_M_size;
+    }
+
+private:
+    static const std::size_t _S_inline = 64;
+
+    std::size_t _M_size;
+    scope _M_inline[_S_inline];
+    std::vector<scope> _M_outline;
+};
+
+
+// Walk over the first value in the range and report the tokens to the
+// handler. The walk validates the structure of the value and throws an
+// encoding error on the first invalid symbol, the offset of the symbol
+// is counted from the @a __first. Returns the pointer right past the
+// value.
+template <typename CharT, typename IntT, typename Traits, typename Handler>
+const CharT*
+__walk_structure(const CharT* __first, const CharT* __p, const CharT* __last,
+    Handler& __handler, const char* __where)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    __scope_stack __scopes;
+
+    do {
+        if (__p == __last) {
+            __throw_structure_error(__where, "unexpected end of the value",
+                __first, __p);
+        }
+
+        auto __ch = *__p;
+        auto __token = __p;
+
+        if (!__scopes.empty() && __scopes.back() == __scope_stack::dict_key) {
+            if (__ch == basic_value_type::end_token) {
+                __handler.end_dict(__token);
+                __scopes.pop();
+                ++__p;
+            } else {
+                // Keys of the dictionary are always strings, which are
+                // followed by the delimiter token.
+                std::size_t __length;
+                __p = __scan_string<CharT, Traits>(
+                    __first, __p, __last, __length, __where);
+
+                if (__p == __last ||
+                        *__p != basic_value_type::delimiter_token) {
+                    __throw_structure_error(__where,
+                        "after the key a `:` delimiter expected",
+                        __first, __p);
+                }
+
+                __handler.key(__token, __p - __length, __length);
+                ++__p;
+                __scopes.back() = __scope_stack::dict_value;
+                continue;
+            }
+        } else if (__ch == basic_value_type::integer_token) {
+            IntT __value;
+            __p = __scan_integer<CharT, IntT, Traits>(
+                __first, __p, __last, __value, __where);
+            __handler.integer(__token, __value);
+        } else if (__ch == basic_value_type::list_token) {
+            __handler.begin_list(__token);
+            __scopes.push(__scope_stack::list);
+            ++__p;
+            continue;
+        } else if (__ch == basic_value_type::dict_token) {
+            __handler.begin_dict(__token);
+            __scopes.push(__scope_stack::dict_key);
+            ++__p;
+            continue;
+        } else if (__ch == basic_value_type::end_token &&
+                !__scopes.empty() && __scopes.back() == __scope_stack::list) {
+            __handler.end_list(__token);
+            __scopes.pop();
+            ++__p;
+        } else if (__ch >= CharT('0') && __ch <= CharT('9')) {
+            std::size_t __length;
+            __p = __scan_string<CharT, Traits>(
+                __first, __p, __last, __length, __where);
+            __handler.string(__token, __p - __length, __length);
+        } else {
+            __throw_structure_error(__where, "unexpected symbol",
+                __first, __p);
+        }
+
+        // The value of the dictionary item is complete, so the next
+        // key or the end of the dictionary is expected.
+        if (!__scopes.empty() &&
+                __scopes.back() == __scope_stack::dict_value) {
+            __scopes.back() = __scope_stack::dict_key;
+        }
+    } while (!__scopes.empty());
+
+    return __p;
+}
+
+
+template <typename CharT, typename IntT, typename Traits, typename Handler>
+const CharT*
+__walk_structure(const CharT* __first, const CharT* __last,
+    Handler& __handler, const char* __where)
+{
+    return __walk_structure<CharT, IntT, Traits>(
+        __first, __first, __last, __handler, __where);
+}
+
+
+// Handler of the structure walk, which collects the offsets of all
+// structural symbols.
+template <typename CharT, typename IntT>
+struct __index_handler
+{
+    const CharT* _M_first;
+    std::vector<std::size_t>& _M_index;
+
+    void
+    push(const CharT* __token)
+    { _M_index.push_back(std::size_t(__token - _M_first)); }
+
+    void
+    integer(const CharT* __token, IntT)
+    { push(__token); }
+
+    void
+    string(const CharT* __token, const CharT*, std::size_t)
+    { push(__token); }
+
+    void
+    key(const CharT* __token, const CharT*, std::size_t)
+    { push(__token); }
+
+    void
+    begin_list(const CharT* __token)
+    { push(__token); }
+
+    void
+    end_list(const CharT* __token)
+    { push(__token); }
+
+    void
+    begin_dict(const CharT* __token)
+    { push(__token); }
+
+    void
+    end_dict(const CharT* __token)
+    { push(__token); }
+};
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Build the structural index of the bencoded value.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __first  Start of the range.
+ *  @param __last   End of the range.
+ *  @param __index  Positions of the structural symbols.
+ *
+ *  Validates the structure of the first value in the range and appends
+ *  the offsets of its structural symbols to the @a __index: the "i",
+ *  "l", "d" and "e" tokens and the first symbol of each string length.
+ *  The payloads of the strings are jumped over using their lengths, so
+ *  the scan never reads them. Throws `encoding_error` with the offset
+ *  of the first invalid symbol. Returns the count of scanned symbols.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::size_t
+index_structure(const CharT* __first, const CharT* __last,
+    std::vector<std::size_t>& __index)
+{
+    __detail::__index_handler<CharT, IntT> __handler{__first, __index};
+    auto __end = __detail::__walk_structure<CharT, IntT, Traits>(
+        __first, __last, __handler, "bencode::index_structure");
+    return std::size_t(__end - __first);
+}
+
+
+/**
+ *  @brief Build the structural index of the bencoded value.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s  Start of the range.
+ *  @param __n  Count of characters in the range.
+ *
+ *  Returns the offsets of the structural symbols of the first value
+ *  in the range.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::vector<std::size_t>
+index_structure(const CharT* __s, std::size_t __n)
+{
+    std::vector<std::size_t> __index;
+    index_structure<CharT, IntT, Traits>(__s, __s + __n, __index);
+    return __index;
+}
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_index_hpp__
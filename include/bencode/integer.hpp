@@ -1,9 +1,9 @@
 #ifndef INCLUDE_bencode_integer_hpp__
 #define INCLUDE_bencode_integer_hpp__
 
-#include <iterator>
 #include <sstream>
 #include <bencode/algorithm.hpp>
+#include <bencode/cursor.hpp>
 #include <bencode/value.hpp>
 
 
@@ -32,10 +32,8 @@ public:
      *  @param __value  Reference to the basic type.
      */
     basic_integer(const basic_value_type& __value)
-    {
-        auto __integer = dynamic_cast<const basic_integer&>(__value);
-        _M_value = __integer._M_value;
-    }
+    : _M_value(dynamic_cast<const basic_integer&>(__value)._M_value)
+    { }
 
     /**
      *  @brief Construct an integer using downcasted pointer to the
@@ -67,6 +65,13 @@ public:
     ~basic_integer()
     { }
 
+    /**
+     *  @brief Replace the value with the value of the specified integer.
+     *  @param __i  Source integer.
+     */
+    basic_integer&
+    operator=(const basic_integer& __i) = default;
+
     /**
      *  @brief Serialize the integer value to the specified output stream.
      *  @param __s  Reference to the input stream.
@@ -82,61 +87,90 @@ public:
      */
     void
     load(std::basic_istream<CharT, Traits> &__s)
+    {
+        basic_streambuf_cursor<CharT, Traits> __c(__s);
+        decode(__c);
+    }
+
+    /**
+     *  @brief Deserialize the integer value from the specified cursor.
+     *  @param __c  Reference to the input cursor.
+     */
+    template <typename Cursor>
+    void
+    decode(Cursor& __c)
     {
         // We must ensure that subsequent actions will be performed
         // for very likely integer value, otherwise and exception
         // should be raised.
-        if (__s.peek() != basic_value_type::integer_token) {
-            throw type_error(
+        if (__c.peek() != basic_value_type::integer_token) {
+            __bencode_throw(type_error(
                 "bencode::integer::load the specified stream does "
-                "not contain interpretable bencode integer value\n");
+                "not contain interpretable bencode integer value\n"));
         }
 
-        // Read the leading "i" symbol from the provided stream.
-        __s.get();
-
-        // Define the integer symbol representation placeholder.
-        std::basic_stringstream<CharT, Traits> __i;
-
-        // Define the input stream iterator of the provided stream to
-        // be able to read the integer value symbol by symbol.
-        auto __si = std::istream_iterator<CharT, CharT, Traits>(__s);
-
-        // Define the output stream to as a buffer for the integer
-        // value, which will be later converted.
-        auto __ival = std::ostream_iterator<CharT, CharT, Traits>(__i);
+        // Read the leading "i" symbol from the provided cursor.
+        __c.get();
 
-        // Copy the values from the input stream into the integer
-        // placeholder string stream.
-        auto __result = copy_until(__si, __ival,
-            [&__s](const CharT& __ch) {
+        // Define the integer symbol representation placeholder, the
+        // count of symbols is limited to prevent the buffer overload.
+        CharT __digits[basic_value_type::integer_length];
+        auto __count = extract_integer(__c, __digits,
+            std::size_t(basic_value_type::integer_length));
+        auto __ch = __c.peek();
 
-            // Additionally, check that we did not exceed the
-            // length of the stream to prevent hangs.
-            return !__s.eof() && __ch != basic_value_type::end_token;
-        }, basic_value_type::integer_length);
-
-        // Covert the value from the string into the integer.
-        __i >> _M_value;
-
-        // The "e" symbol should be already extracted at this moment,
-        // so validate that the iterator pointing right to it.
-        if (*__result != basic_value_type::end_token) {
+        // Validate that the cursor is pointing right to the "e" symbol.
+        if (__ch != basic_value_type::end_token) {
             std::ostringstream __error;
 
+            // The symbols limit is reached, but the integer is longer.
+            if (__count == std::size_t(basic_value_type::integer_length)) {
+                __error << "bencode::integer::load the specified "
+                    "value is out of range of the integer type\n";
+                __bencode_throw(value_error(__error.str()));
+            }
+
+            // The integer is not started with a digit at all.
+            if (!__count && !Traits::eq_int_type(__ch, Traits::eof())) {
+                __error << "bencode::integer::load the specified "
+                    "value is not a number\n";
+                __bencode_throw(value_error(__error.str()));
+            }
+
+            // When the input is exhausted, report the last extracted
+            // symbol, since there is nothing else to show.
+            if (Traits::eq_int_type(__ch, Traits::eof()) && __count) {
+                __ch = Traits::to_int_type(__digits[__count-1]);
+            }
+
             __error << "bencode::integer::load the end of the integer "
-                "`e` expected, but `" << CharT(*__result) << "` found\n";
-            throw encoding_error(__error.str());
+                "`e` expected, but `" << CharT(__ch) << "` found\n";
+            __bencode_throw(encoding_error(__error.str()));
         }
 
-        // Validate that decoded value is an actual integer.
-        if (!_M_value && __i.str() != std::basic_string<
-                CharT, Traits>(1, CharT('0'))) {
-            std::ostringstream __error;
-
-            __error << "bencode::integer::load the specified "
-                "value is not a number\n";
-            throw value_error(__error.str());
+        // Read the "e" symbol from the provided cursor.
+        __c.get();
+
+        // Covert the value from the symbols into the integer.
+        switch (decode_integer(__digits, __digits + __count, _M_value)) {
+        case integer_errc::success:
+            break;
+        case integer_errc::leading_zero:
+            __bencode_throw(value_error(
+                "bencode::integer::load the specified "
+                "value has redundant leading zeros\n"));
+        case integer_errc::negative_zero:
+            __bencode_throw(value_error(
+                "bencode::integer::load the specified "
+                "value is a negative zero\n"));
+        case integer_errc::out_of_range:
+            __bencode_throw(value_error(
+                "bencode::integer::load the specified "
+                "value is out of range of the integer type\n"));
+        default:
+            __bencode_throw(value_error(
+                "bencode::integer::load the specified "
+                "value is not a number\n"));
         }
     }
 
@@ -0,0 +1,833 @@
+#ifndef INCLUDE_bencode_lazy_hpp__
+#define INCLUDE_bencode_lazy_hpp__
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <utility>
+#include <bencode/cursor.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/skip.hpp>
+#include <bencode/string.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+template<__bencode_dict_template> class basic_lazy_dict;
+
+
+template<__bencode_list_template> class basic_lazy_list;
+
+
+namespace __detail
+{
+
+
+// Cursor adapter, which records all extracted symbols into the string.
+template <typename Cursor, typename String>
+class __recording_cursor
+{
+public:
+    using char_type = typename Cursor::char_type;
+
+    using traits_type = typename Cursor::traits_type;
+
+    using int_type = typename Cursor::int_type;
+
+    __recording_cursor(Cursor& __c, String& __str)
+    : _M_cursor(__c), _M_str(__str)
+    { }
+
+    int_type
+    peek() const
+    { return _M_cursor.peek(); }
+
+    int_type
+    get()
+    {
+        auto __ch = _M_cursor.get();
+        if (!traits_type::eq_int_type(__ch, traits_type::eof())) {
+            _M_str.push_back(traits_type::to_char_type(__ch));
+        }
+        return __ch;
+    }
+
+    std::size_t
+    read(char_type* __s, std::size_t __n)
+    {
+        auto __count = _M_cursor.read(__s, __n);
+        _M_str.append(__s, __count);
+        return __count;
+    }
+
+    std::size_t
+    ignore(std::size_t __n)
+    {
+        std::size_t __count = 0;
+        for (; __count < __n; ++__count) {
+            if (traits_type::eq_int_type(get(), traits_type::eof())) {
+                break;
+            }
+        }
+        return __count;
+    }
+
+    bool
+    available(std::size_t __n) const
+    { return _M_cursor.available(__n); }
+
+    std::size_t
+    remaining() const
+    { return _M_cursor.remaining(); }
+
+    std::size_t
+    position() const
+    { return _M_cursor.position(); }
+
+private:
+    Cursor& _M_cursor;
+    String& _M_str;
+};
+
+
+// Location of the encoded child value in the source of the lazy
+// container and the decoded value, once it was accessed.
+template <typename ValuePtr>
+struct __lazy_slot
+{
+    std::size_t _M_first;
+    std::size_t _M_last;
+    bool _M_loaded;
+    ValuePtr _M_value;
+
+    __lazy_slot(std::size_t __first = 0, std::size_t __last = 0)
+    : _M_first(__first), _M_last(__last), _M_loaded(__first == __last)
+    { }
+};
+
+
+// Decode the child value of the lazy container. Nested lists and
+// dictionaries are decoded lazily as well and share the same source.
+template<__bencode_dict_template>
+std::shared_ptr<basic_value<CharT, Traits>>
+__decode_lazy(const std::shared_ptr<const std::basic_string<CharT, Traits>>&
+    __source, std::size_t __first, std::size_t __last)
+{
+    using basic_type = basic_value<CharT, Traits>;
+    using list_type = basic_lazy_list<__bencode_list_typenames>;
+    using dict_type = basic_lazy_dict<__bencode_dict_typenames>;
+
+    switch ((*__source)[__first])
+    {
+    case basic_type::list_token:
+        return std::make_shared<list_type>(__source, __first, __last);
+    case basic_type::dict_token:
+        return std::make_shared<dict_type>(__source, __first, __last);
+    default:
+        return parse<__bencode_dict_typenames>(
+            __source->data() + __first, __last - __first).first;
+    }
+}
+
+
+// Copy the symbols of the first value available from the cursor into
+// the string.
+template <typename CharT, typename IntT, typename Traits, typename Cursor>
+void
+__capture_value(Cursor& __c, std::basic_string<CharT, Traits>& __str)
+{
+    using string_type = std::basic_string<CharT, Traits>;
+
+    __recording_cursor<Cursor, string_type> __rc(__c, __str);
+    __skip_value<CharT, IntT, Traits>(__rc);
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Template class basic_lazy_dict.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  Define the type of associative array, which decodes its values on
+ *  the first access. On decoding the dictionary only the keys are
+ *  decoded, while for the values just the locations in the encoded
+ *  source are recorded.
+ */
+template
+< typename CharT
+, typename IntT
+, typename Traits
+, template
+< typename T
+> class Allocator
+, template
+< typename Key
+, typename T
+, typename... Args
+> class DictContainer
+, template
+< typename T
+, typename... Args
+> class ListContainer
+> class basic_lazy_dict : public basic_value<CharT, Traits>
+{
+private:
+    // Define the dictionary key alias.
+    using key_type = basic_string<CharT, Traits, Allocator>;
+
+    // Define the dictionary value alias.
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    // Define the shared pointer type of basic values.
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    // Define the slot type of the dictionary values.
+    using slot_type = __detail::__lazy_slot<value_ptr_type>;
+
+    // Define the lexicographical comparator as a wrapper
+    // around the STL function.
+    struct lexicographical_compare
+    {
+        bool
+        operator()(const key_type& lhs, const key_type& rhs) const
+        {
+            return std::lexicographical_compare(
+                lhs.cbegin(), lhs.cend(),
+                rhs.cbegin(), rhs.cend());
+        }
+    };
+
+public:
+    /**
+     *  @brief Shared pointer to the encoded source of the dictionary.
+     */
+    using source_ptr = std::shared_ptr<const std::basic_string<CharT, Traits>>;
+
+    /**
+     *  @brief Dictionary container type to keep the map of the slots.
+     */
+    using container_type = DictContainer<key_type, slot_type,
+        lexicographical_compare, Allocator<std::pair<const key_type,
+        slot_type>>>;
+
+    /**
+     *  @brief Unsigned integral type of the dictionary size.
+     */
+    using size_type = typename container_type::size_type;
+
+    /**
+     *  @brief Template class iterator.
+     *
+     *  Forward iterator over the items of the dictionary, which decodes
+     *  the values as they are dereferenced.
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = std::pair<const key_type&, value_ptr_type&>;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = void;
+
+        using reference = value_type;
+
+        iterator(basic_lazy_dict* __dict,
+            typename container_type::iterator __it)
+        : _M_dict(__dict), _M_it(__it)
+        { }
+
+        /**
+         *  @brief Returns the key and the decoded value of the item.
+         */
+        reference
+        operator*() const
+        { return reference(_M_it->first, value()); }
+
+        /**
+         *  @brief Returns the key of the item.
+         */
+        const key_type&
+        key() const
+        { return _M_it->first; }
+
+        /**
+         *  @brief Returns the decoded value of the item.
+         */
+        value_ptr_type&
+        value() const
+        { return _M_dict->_M_load(_M_it->second); }
+
+        iterator&
+        operator++()
+        { ++_M_it; return *this; }
+
+        iterator
+        operator++(int)
+        { auto __it = *this; ++_M_it; return __it; }
+
+        bool
+        operator==(const iterator& __it) const
+        { return _M_it == __it._M_it; }
+
+        bool
+        operator!=(const iterator& __it) const
+        { return _M_it != __it._M_it; }
+
+    private:
+        basic_lazy_dict* _M_dict;
+        typename container_type::iterator _M_it;
+    };
+
+    /**
+     *  @brief Construct an empty dictionary.
+     */
+    basic_lazy_dict()
+    { }
+
+    /**
+     *  @brief Construct a dictionary using downcasted reference to the
+     *         basic type.
+     *  @param __value  Reference to the basic type.
+     */
+    basic_lazy_dict(const basic_value_type& __value)
+    : basic_lazy_dict(dynamic_cast<const basic_lazy_dict&>(__value))
+    { }
+
+    /**
+     *  @brief Construct a dictionary using downcasted pointer to the
+     *         basic type.
+     *  @param __ptr  Shared pointer to the basic type.
+     *
+     *  The pointer should not be equal to `nullptr`, it will not be checked.
+     */
+    basic_lazy_dict(const std::shared_ptr<basic_value_type>& __ptr)
+    : basic_lazy_dict(*__ptr)
+    { }
+
+    /**
+     *  @brief Construct a dictionary over the range of the encoded source.
+     *  @param __source  Encoded source of the dictionary.
+     *  @param __first   Offset of the first symbol of the dictionary.
+     *  @param __last    Offset past the last symbol of the dictionary.
+     *
+     *  Only the keys are decoded, the values are decoded on access.
+     */
+    basic_lazy_dict(const source_ptr& __source, std::size_t __first,
+        std::size_t __last)
+    { _M_scan(__source, __first, __last); }
+
+    basic_lazy_dict(const basic_lazy_dict& __dict) = default;
+
+    ~basic_lazy_dict()
+    { }
+
+    /**
+     *  @brief Decode the first value of the range into the dictionary.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     *
+     *  The encoded value is copied, so the range could be released
+     *  right after the call. Returns the count of consumed characters.
+     */
+    std::size_t
+    parse(const CharT* __s, std::size_t __n)
+    {
+        auto __count = __detail::__skip_value<CharT, IntT, Traits>(
+            __s, __n, "bencode::lazy_dict::parse");
+
+        auto __source = std::make_shared<std::basic_string<CharT, Traits>>(
+            __s, __count);
+        _M_scan(__source, 0, __source->size());
+        return __source->size();
+    }
+
+    /**
+     *  @brief Serialize the dictionary value to the specified output stream.
+     *  @param __s  Reference to the output stream.
+     *
+     *  The values, which were not accessed, are copied from the source
+     *  without decoding.
+     */
+    void
+    dump(std::basic_ostream<CharT, Traits>& __s) const
+    {
+        __s << basic_value_type::dict_token;
+
+        for (auto __it = _M_container.cbegin(); __it != _M_container.cend();
+                ++__it) {
+            auto& __slot = __it->second;
+            if (__slot._M_loaded && __slot._M_value == nullptr) {
+                continue;
+            }
+
+            __it->first.dump(__s);
+            __s << basic_value_type::delimiter_token;
+
+            if (__slot._M_loaded) {
+                __slot._M_value->dump(__s);
+            } else {
+                __s.write(_M_source->data() + __slot._M_first,
+                    std::streamsize(__slot._M_last - __slot._M_first));
+            }
+        }
+
+        __s << basic_value_type::end_token;
+    }
+
+    /**
+     *  @brief Deserialize the dictionary value from the specified
+     *         input stream.
+     *  @param __s  Reference to the input stream.
+     */
+    void
+    load(std::basic_istream<CharT, Traits>& __s)
+    {
+        basic_streambuf_cursor<CharT, Traits> __c(__s);
+
+        auto __source = std::make_shared<std::basic_string<CharT, Traits>>();
+        __detail::__capture_value<CharT, IntT, Traits>(__c, *__source);
+        _M_scan(__source, 0, __source->size());
+    }
+
+    /**
+     *  @brief Iterator to the first element.
+     */
+    iterator
+    begin()
+    { return iterator(this, _M_container.begin()); }
+
+    /**
+     *  @brief Iterator one past the last element.
+     */
+    iterator
+    end()
+    { return iterator(this, _M_container.end()); }
+
+    /**
+     *  @brief Subscript access to the data container in the %dict.
+     *  @param __key  The key of the element for which data should be
+     *                accessed.
+     *
+     *  Decodes the value on the first access. Returns read/write
+     *  reference to the data.
+     */
+    value_ptr_type&
+    operator[](const CharT* __key)
+    { return _M_load(_M_container[key_type(__key)]); }
+
+    /**
+     *  @brief Count the elements with the specified key.
+     *  @param __key  The key of the element to count.
+     */
+    size_type
+    count(const CharT* __key) const
+    { return _M_container.count(key_type(__key)); }
+
+    /**
+     *  @brief Returns the number of elements in the container.
+     */
+    size_type
+    size() const
+    { return _M_container.size(); }
+
+private:
+    // Decode the value of the slot, unless it is already decoded.
+    value_ptr_type&
+    _M_load(slot_type& __slot)
+    {
+        if (!__slot._M_loaded) {
+            __slot._M_value = __detail::__decode_lazy<
+                __bencode_dict_typenames>(_M_source, __slot._M_first,
+                __slot._M_last);
+            __slot._M_loaded = true;
+        }
+        return __slot._M_value;
+    }
+
+    // Record the locations of the values of the dictionary.
+    void
+    _M_scan(const source_ptr& __source, std::size_t __first,
+        std::size_t __last)
+    {
+        auto __begin = __source->data();
+        basic_buffer_cursor<CharT, Traits> __c(__begin + __first,
+            __begin + __last);
+
+        if (__c.peek() != basic_value_type::dict_token) {
+            __bencode_throw(type_error(
+                "bencode::lazy_dict::load the specified stream does not "
+                "contain interpretable bencode dictionary value\n"));
+        }
+
+        __c.get();
+        container_type __container;
+
+        while (__c.peek() != basic_value_type::end_token) {
+            key_type __key;
+            __key.decode(__c);
+
+            if (__c.get() != basic_value_type::delimiter_token) {
+                __bencode_throw(encoding_error(
+                    "bencode::lazy_dict::load after "
+                    "the key a `:` delimiter expected\n"));
+            }
+
+            // Jump over the value, but remember its location.
+            auto __value = __c.current();
+            __c.ignore(__detail::__skip_value<CharT, IntT, Traits>(
+                __value, __c.remaining(), "bencode::lazy_dict::load"));
+            auto __end = __c.current();
+
+            __container.insert(std::make_pair(__key, slot_type(
+                std::size_t(__value - __begin),
+                std::size_t(__end - __begin))));
+        }
+
+        _M_source = __source;
+        _M_container.swap(__container);
+    }
+
+    // The encoded source of the dictionary.
+    source_ptr _M_source;
+
+    // The associative list of the keys and the value slots.
+    container_type _M_container;
+};
+
+
+/**
+ *  @brief Template class basic_lazy_list.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *
+ *  Define the type of array, which decodes its elements on the first
+ *  access. On decoding the list only the locations of the elements in
+ *  the encoded source are recorded.
+ */
+template
+< typename CharT
+, typename IntT
+, typename Traits
+, template
+< typename T
+> class Allocator
+, template
+< typename T
+, typename... Args
+> class ListContainer
+, template
+< typename Key
+, typename T
+, typename... Args
+> class DictContainer
+> class basic_lazy_list : public basic_value<CharT, Traits>
+{
+private:
+    // Define the list value alias.
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    // Define the slot type of the list elements.
+    using slot_type = __detail::__lazy_slot<value_ptr_type>;
+
+public:
+    /**
+     *  @brief Shared pointer to the encoded source of the list.
+     */
+    using source_ptr = std::shared_ptr<const std::basic_string<CharT, Traits>>;
+
+    /**
+     *  @brief List container type of the element slots.
+     */
+    using container_type = ListContainer<slot_type, Allocator<slot_type>>;
+
+    /**
+     *  @brief Unsigned integral type of the list size.
+     */
+    using size_type = typename container_type::size_type;
+
+    /**
+     *  @brief Template class iterator.
+     *
+     *  Forward iterator over the elements of the list, which decodes
+     *  the elements as they are dereferenced.
+     */
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+
+        using value_type = value_ptr_type;
+
+        using difference_type = std::ptrdiff_t;
+
+        using pointer = value_ptr_type*;
+
+        using reference = value_ptr_type&;
+
+        iterator(basic_lazy_list* __list,
+            typename container_type::iterator __it)
+        : _M_list(__list), _M_it(__it)
+        { }
+
+        /**
+         *  @brief Returns the decoded element.
+         */
+        reference
+        operator*() const
+        { return _M_list->_M_load(*_M_it); }
+
+        pointer
+        operator->() const
+        { return &**this; }
+
+        iterator&
+        operator++()
+        { ++_M_it; return *this; }
+
+        iterator
+        operator++(int)
+        { auto __it = *this; ++_M_it; return __it; }
+
+        bool
+        operator==(const iterator& __it) const
+        { return _M_it == __it._M_it; }
+
+        bool
+        operator!=(const iterator& __it) const
+        { return _M_it != __it._M_it; }
+
+    private:
+        basic_lazy_list* _M_list;
+        typename container_type::iterator _M_it;
+    };
+
+    /**
+     *  @brief Construct an empty list.
+     */
+    basic_lazy_list()
+    { }
+
+    /**
+     *  @brief Construct a list using downcasted reference to the basic type.
+     *  @param __value  Reference to the basic type.
+     */
+    basic_lazy_list(const basic_value_type& __value)
+    : basic_lazy_list(dynamic_cast<const basic_lazy_list&>(__value))
+    { }
+
+    /**
+     *  @brief Construct a list using downcasted pointer to the basic type.
+     *  @param __ptr  Shared pointer to the basic type.
+     *
+     *  The pointer should not be equal to `nullptr`, it will not be checked.
+     */
+    basic_lazy_list(const std::shared_ptr<basic_value_type>& __ptr)
+    : basic_lazy_list(*__ptr)
+    { }
+
+    /**
+     *  @brief Construct a list over the range of the encoded source.
+     *  @param __source  Encoded source of the list.
+     *  @param __first   Offset of the first symbol of the list.
+     *  @param __last    Offset past the last symbol of the list.
+     *
+     *  The elements are decoded on access.
+     */
+    basic_lazy_list(const source_ptr& __source, std::size_t __first,
+        std::size_t __last)
+    { _M_scan(__source, __first, __last); }
+
+    basic_lazy_list(const basic_lazy_list& __list) = default;
+
+    ~basic_lazy_list()
+    { }
+
+    /**
+     *  @brief Decode the first value of the range into the list.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     *
+     *  The encoded value is copied, so the range could be released
+     *  right after the call. Returns the count of consumed characters.
+     */
+    std::size_t
+    parse(const CharT* __s, std::size_t __n)
+    {
+        auto __count = __detail::__skip_value<CharT, IntT, Traits>(
+            __s, __n, "bencode::lazy_list::parse");
+
+        auto __source = std::make_shared<std::basic_string<CharT, Traits>>(
+            __s, __count);
+        _M_scan(__source, 0, __source->size());
+        return __source->size();
+    }
+
+    /**
+     *  @brief Serialize the list value to the specified output stream.
+     *  @param __s  Reference to the output stream.
+     *
+     *  The elements, which were not accessed, are copied from the source
+     *  without decoding.
+     */
+    void
+    dump(std::basic_ostream<CharT, Traits>& __s) const
+    {
+        __s << basic_value_type::list_token;
+
+        for (auto __it = _M_container.cbegin(); __it != _M_container.cend();
+                ++__it) {
+            if (!__it->_M_loaded) {
+                __s.write(_M_source->data() + __it->_M_first,
+                    std::streamsize(__it->_M_last - __it->_M_first));
+            } else if (__it->_M_value != nullptr) {
+                __it->_M_value->dump(__s);
+            }
+        }
+
+        __s << basic_value_type::end_token;
+    }
+
+    /**
+     *  @brief Deserialize the list value from the specified input stream.
+     *  @param __s  Reference to the input stream.
+     */
+    void
+    load(std::basic_istream<CharT, Traits>& __s)
+    {
+        basic_streambuf_cursor<CharT, Traits> __c(__s);
+
+        auto __source = std::make_shared<std::basic_string<CharT, Traits>>();
+        __detail::__capture_value<CharT, IntT, Traits>(__c, *__source);
+        _M_scan(__source, 0, __source->size());
+    }
+
+    /**
+     *  @brief Iterator to the first element.
+     */
+    iterator
+    begin()
+    { return iterator(this, _M_container.begin()); }
+
+    /**
+     *  @brief Iterator one past the last element.
+     */
+    iterator
+    end()
+    { return iterator(this, _M_container.end()); }
+
+    /**
+     *  @brief Subscript access to the data container in the %list.
+     *  @param __index  The index of the element for which data should be
+     *                  accessed.
+     *
+     *  Decodes the element on the first access. Returns read/write
+     *  reference to data.
+     */
+    value_ptr_type&
+    operator[](std::size_t __index)
+    { return _M_load(_M_container[__index]); }
+
+    /**
+     *  @brief Returns the number of elements in the container.
+     */
+    size_type
+    size() const
+    { return _M_container.size(); }
+
+private:
+    // Decode the element of the slot, unless it is already decoded.
+    value_ptr_type&
+    _M_load(slot_type& __slot)
+    {
+        if (!__slot._M_loaded) {
+            __slot._M_value = __detail::__decode_lazy<
+                __bencode_dict_typenames>(_M_source, __slot._M_first,
+                __slot._M_last);
+            __slot._M_loaded = true;
+        }
+        return __slot._M_value;
+    }
+
+    // Record the locations of the elements of the list.
+    void
+    _M_scan(const source_ptr& __source, std::size_t __first,
+        std::size_t __last)
+    {
+        auto __begin = __source->data();
+        auto __p = __begin + __first;
+
+        if (__first == __last || *__p != basic_value_type::list_token) {
+            __bencode_throw(type_error(
+                "bencode::lazy_list::load the specified stream does "
+                "not contain interpretable bencode list value\n"));
+        }
+
+        ++__p;
+        container_type __container;
+
+        while (*__p != basic_value_type::end_token) {
+            // Jump over the element, but remember its location.
+            auto __end = __p + __detail::__skip_value<CharT, IntT, Traits>(
+                __p, std::size_t(__begin + __last - __p),
+                "bencode::lazy_list::load");
+
+            __container.push_back(slot_type(std::size_t(__p - __begin),
+                std::size_t(__end - __begin)));
+            __p = __end;
+        }
+
+        _M_source = __source;
+        _M_container.swap(__container);
+    }
+
+    // The encoded source of the list.
+    source_ptr _M_source;
+
+    // The collection of the element slots.
+    container_type _M_container;
+};
+
+
+typedef basic_lazy_dict<char> lazy_dict;
+
+
+typedef basic_lazy_dict<wchar_t> wlazy_dict;
+
+
+typedef basic_lazy_list<char> lazy_list;
+
+
+typedef basic_lazy_list<wchar_t> wlazy_list;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_lazy_hpp__
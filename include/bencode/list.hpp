@@ -5,6 +5,7 @@
 #include <iterator>
 #include <sstream>
 #include <initializer_list>
+#include <bencode/cursor.hpp>
 #include <bencode/value.hpp>
 
 
@@ -67,11 +68,8 @@ public:
      *  @param __value  Reference to the basic type.
      */
     basic_list(const basic_value_type& __value)
-    {
-        auto __list = dynamic_cast<const basic_list&>(__value);
-        // Explicitly copy the containers content.
-        _M_container = container_type(__list._M_container);
-    }
+    : _M_container(dynamic_cast<const basic_list&>(__value)._M_container)
+    { }
 
     /**
      *  @brief Construct a list using downcasted pointer to the basic type.
@@ -108,9 +106,32 @@ public:
     : _M_container(__first, __last)
     { }
 
+    /**
+     *  @brief Construct a list as a copy of @a list.
+     *  @param __list  Source list.
+     */
+    basic_list(const basic_list& __list)
+    : _M_container(__list._M_container)
+    { }
+
+    /**
+     *  @brief Construct a list with the elements of @a list, the source
+     *         list is left empty.
+     *  @param __list  Source list.
+     */
+    basic_list(basic_list&& __list) noexcept
+    : _M_container(std::move(__list._M_container))
+    { }
+
     ~basic_list()
     { }
 
+    basic_list&
+    operator=(const basic_list& __list) = default;
+
+    basic_list&
+    operator=(basic_list&& __list) = default;
+
     /**
      *  @brief Serialize the list value to the specified output stream.
      *  @param __s  Reference to the output stream.
@@ -137,43 +158,57 @@ public:
      */
     void
     load(std::basic_istream<CharT, Traits>& __s)
+    {
+        basic_streambuf_cursor<CharT, Traits> __c(__s);
+        decode(__c);
+    }
+
+    /**
+     *  @brief Deserialize the list value from the specified cursor.
+     *  @param __c  Reference to the input cursor.
+     */
+    template <typename Cursor>
+    void
+    decode(Cursor& __c)
     {
         // Ensure that the stream is starting with the valid
         // list token, otherwise all subsequent actions will
         // make more damage.
-        if (__s.peek() != basic_value_type::list_token) {
-            throw type_error(
+        if (__c.peek() != basic_value_type::list_token) {
+            __bencode_throw(type_error(
                 "bencode::list::load the specified stream does "
-                "not contain interpretable bencode list value\n");
+                "not contain interpretable bencode list value\n"));
         }
 
-        // Read the "l" symbols from the provided stream.
-        __s.get();
+        // Read the "l" symbols from the provided cursor.
+        __c.get();
 
         // Decode the Bencode values one by one until the
         // end of the stream or the list token.
-        while (!__s.eof() && __s.peek() != basic_value_type::end_token) {
+        auto __ch = __c.peek();
+        while (!Traits::eq_int_type(__ch, Traits::eof())
+                && __ch != basic_value_type::end_token) {
             // Decode the value of the next list item.
-            auto __value = make_value<__bencode_dict_typenames>(__s);
+            auto __value = decode_value<__bencode_dict_typenames>(__c);
 
             // Append the decoded item to the list.
-            _M_container.push_back(__value);
+            _M_container.push_back(std::move(__value));
 
-            // Force read the next symbol from the stream.
-            __s.peek();
+            // Look at the next symbol of the cursor.
+            __ch = __c.peek();
         }
 
         // Ensure that the list value is succefully de-serialized.
-        if (__s.peek() != basic_value_type::end_token) {
+        if (__ch != basic_value_type::end_token) {
             std::ostringstream __error;
 
             __error << "bencode::list::load the end of the list "
-                "`e` expected, but `" << CharT(__s.peek()) << "` found\n";
-            throw encoding_error(__error.str());
+                "`e` expected, but `" << CharT(__ch) << "` found\n";
+            __bencode_throw(encoding_error(__error.str()));
         }
 
-        // Read the "e" symbol from the provided stream.
-        __s.get();
+        // Read the "e" symbol from the provided cursor.
+        __c.get();
     }
 
     /**
@@ -236,6 +271,14 @@ public:
     insert(const value_ptr_type& __value)
     { return _M_container.insert(_M_container.end(), __value); }
 
+    /**
+     *  @brief Move data to the end of the %list.
+     *  @param __value  Data to be added.
+     */
+    iterator
+    insert(value_ptr_type&& __value)
+    { return _M_container.insert(_M_container.end(), std::move(__value)); }
+
     /**
      *  @brief Inserts elements at the specified location in the container.
      *  @param __pos    Mutable iterator before which the content will be
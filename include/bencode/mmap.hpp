@@ -0,0 +1,149 @@
+#ifndef INCLUDE_bencode_mmap_hpp__
+#define INCLUDE_bencode_mmap_hpp__
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <bencode/document.hpp>
+
+
+namespace bencode
+{
+namespace __detail
+{
+
+
+// Throw the error of the failed system call. The error number should be
+// saved right after the call, since the cleanup could overwrite `errno`.
+[[noreturn]] inline void
+__throw_system_error(int __errnum, const char* __what,
+    const std::string& __path)
+{
+    __bencode_throw(std::system_error(__errnum, std::generic_category(),
+        std::string("bencode::map_file ") + __what + " `" + __path + "`"));
+}
+
+
+// Read-only mapping of the file, which is unmapped on destruction.
+class __file_mapping
+{
+public:
+    explicit
+    __file_mapping(const std::string& __path)
+    : _M_addr(nullptr), _M_length(0)
+    {
+        int __fd = ::open(__path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (__fd < 0) {
+            __throw_system_error(errno, "failed to open", __path);
+        }
+
+        struct stat __st;
+        if (::fstat(__fd, &__st) < 0) {
+            auto __errnum = errno;
+            ::close(__fd);
+            __throw_system_error(__errnum, "failed to stat", __path);
+        }
+
+        // The empty files could not be mapped, so they are represented
+        // with the empty range.
+        if (__st.st_size > 0) {
+            auto __addr = ::mmap(nullptr, std::size_t(__st.st_size),
+                PROT_READ, MAP_PRIVATE, __fd, 0);
+            if (__addr == MAP_FAILED) {
+                auto __errnum = errno;
+                ::close(__fd);
+                __throw_system_error(__errnum, "failed to map", __path);
+            }
+
+            _M_addr = __addr;
+            _M_length = std::size_t(__st.st_size);
+        }
+
+        // The mapping stays valid after the descriptor is closed.
+        ::close(__fd);
+    }
+
+    __file_mapping(const __file_mapping&) = delete;
+
+    __file_mapping&
+    operator=(const __file_mapping&) = delete;
+
+    ~__file_mapping()
+    {
+        if (_M_addr) {
+            ::munmap(_M_addr, _M_length);
+        }
+    }
+
+    // Give the hint about the expected access pattern of the pages.
+    void
+    advise(int __advice) const
+    {
+        if (_M_addr) {
+            ::madvise(_M_addr, _M_length, __advice);
+        }
+    }
+
+    const char*
+    data() const
+    { return static_cast<const char*>(_M_addr); }
+
+    std::size_t
+    size() const
+    { return _M_length; }
+
+private:
+    void* _M_addr;
+    std::size_t _M_length;
+};
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Decode the document from the memory-mapped file.
+ *
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<char>`.
+ *
+ *  @param __path  Path to the file.
+ *
+ *  Maps the file read-only and decodes the first value of the file
+ *  without copying it. The pages are advised for the sequential access
+ *  while the value is scanned. The strings of the document refer to the
+ *  mapped pages, the mapping is released together with the last copy of
+ *  the document. Throws `std::system_error` when the file could not be
+ *  mapped and `encoding_error` when the value is malformed.
+ */
+template
+< typename IntT = int64_t
+, typename Traits = std::char_traits<char>
+> basic_document<char, IntT, Traits>
+map_file(const std::string& __path)
+{
+    auto __mapping = std::make_shared<__detail::__file_mapping>(__path);
+
+    __mapping->advise(MADV_SEQUENTIAL);
+
+    basic_document<char, IntT, Traits> __doc;
+    __doc.parse(__mapping, __mapping->data(), __mapping->size());
+
+    // The values of the document are accessed in an arbitrary order
+    // after the scan.
+    __mapping->advise(MADV_NORMAL);
+    return __doc;
+}
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_mmap_hpp__
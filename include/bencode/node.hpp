@@ -0,0 +1,727 @@
+#ifndef INCLUDE_bencode_node_hpp__
+#define INCLUDE_bencode_node_hpp__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+#include <bencode/algorithm.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/error.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/skip.hpp>
+#include <bencode/string.hpp>
+#include <bencode/validate.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Types of the values stored in the node.
+ */
+enum class node_type : unsigned char
+{
+    integer,
+    string,
+    list,
+    dict
+};
+
+
+/**
+ *  @brief Template class basic_node.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  Value-semantic bencode value, which keeps the integer, the string,
+ *  the list or the dictionary in the tagged union. There is no virtual
+ *  dispatch and no reference counting, the elements are stored inline
+ *  in the containers. The items of the dictionary are kept in the
+ *  vector sorted by the raw characters of the keys.
+ */
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> class basic_node
+{
+private:
+    using basic_value_type = basic_value<CharT, Traits>;
+
+public:
+    using integer_type = IntT;
+
+    using string_type = std::basic_string<CharT, Traits>;
+
+    using list_type = std::vector<basic_node>;
+
+    using item_type = std::pair<string_type, basic_node>;
+
+    using dict_type = std::vector<item_type>;
+
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Construct an integer node.
+     *  @param __i  Value of the integer.
+     */
+    basic_node(integer_type __i = 0) noexcept
+    : _M_type(node_type::integer), _M_integer(__i)
+    { }
+
+    /**
+     *  @brief Construct a string node.
+     *  @param __s  Value of the string.
+     */
+    basic_node(string_type __s)
+    : _M_type(node_type::string)
+    { new (&_M_string) string_type(std::move(__s)); }
+
+    /**
+     *  @brief Construct a string node.
+     *  @param __s  Null-terminated value of the string.
+     */
+    basic_node(const CharT* __s)
+    : basic_node(string_type(__s))
+    { }
+
+    /**
+     *  @brief Construct a list node.
+     *  @param __l  Elements of the list.
+     */
+    basic_node(list_type __l)
+    : _M_type(node_type::list)
+    { new (&_M_list) list_type(std::move(__l)); }
+
+    /**
+     *  @brief Construct a dictionary node.
+     *  @param __d  Items of the dictionary, which are sorted and the
+     *              duplicate keys are dropped, except of the first one.
+     */
+    basic_node(dict_type __d)
+    : _M_type(node_type::dict)
+    {
+        new (&_M_dict) dict_type();
+        for (auto& __item : __d) {
+            insert(std::move(__item.first), std::move(__item.second));
+        }
+    }
+
+    /**
+     *  @brief Construct a node from the value of the class hierarchy.
+     *  @param __ptr  Shared pointer to the basic type.
+     *
+     *  The pointer should not be equal to `nullptr`, it will not be
+     *  checked. The whole value is copied.
+     */
+    explicit
+    basic_node(const value_ptr_type& __ptr)
+    : basic_node()
+    { _M_from_value(__ptr); }
+
+    basic_node(const basic_node& __n)
+    : _M_type(node_type::integer)
+    { _M_construct(__n); }
+
+    basic_node(basic_node&& __n) noexcept
+    : _M_type(node_type::integer)
+    { _M_construct(std::move(__n)); }
+
+    basic_node&
+    operator=(const basic_node& __n)
+    {
+        if (this != &__n) {
+            basic_node __copy(__n);
+            _M_destroy();
+            _M_construct(std::move(__copy));
+        }
+        return *this;
+    }
+
+    basic_node&
+    operator=(basic_node&& __n) noexcept
+    {
+        if (this != &__n) {
+            _M_destroy();
+            _M_construct(std::move(__n));
+        }
+        return *this;
+    }
+
+    ~basic_node()
+    { _M_destroy(); }
+
+    /**
+     *  @brief Returns the type of the stored value.
+     */
+    node_type
+    type() const noexcept
+    { return _M_type; }
+
+    bool
+    is_integer() const noexcept
+    { return _M_type == node_type::integer; }
+
+    bool
+    is_string() const noexcept
+    { return _M_type == node_type::string; }
+
+    bool
+    is_list() const noexcept
+    { return _M_type == node_type::list; }
+
+    bool
+    is_dict() const noexcept
+    { return _M_type == node_type::dict; }
+
+    /**
+     *  @brief Returns the integer value, throws `type_error` when the node
+     *         keeps the value of the different type.
+     */
+    integer_type
+    integer() const
+    { return _M_check(node_type::integer, "an integer"), _M_integer; }
+
+    /**
+     *  @brief Returns the reference to the string value.
+     */
+    string_type&
+    string()
+    { return _M_check(node_type::string, "a string"), _M_string; }
+
+    const string_type&
+    string() const
+    { return _M_check(node_type::string, "a string"), _M_string; }
+
+    /**
+     *  @brief Returns the reference to the list value.
+     */
+    list_type&
+    list()
+    { return _M_check(node_type::list, "a list"), _M_list; }
+
+    const list_type&
+    list() const
+    { return _M_check(node_type::list, "a list"), _M_list; }
+
+    /**
+     *  @brief Returns the reference to the sorted items of the dictionary.
+     *
+     *  The items should be kept sorted when they are modified.
+     */
+    dict_type&
+    dict()
+    { return _M_check(node_type::dict, "a dictionary"), _M_dict; }
+
+    const dict_type&
+    dict() const
+    { return _M_check(node_type::dict, "a dictionary"), _M_dict; }
+
+    /**
+     *  @brief Returns the count of elements of the list or the dictionary.
+     */
+    size_type
+    size() const
+    {
+        if (_M_type == node_type::dict) {
+            return _M_dict.size();
+        }
+        return list().size();
+    }
+
+    /**
+     *  @brief Access the element of the list.
+     *  @param __index  Index of the element.
+     */
+    basic_node&
+    operator[](size_type __index)
+    { return list()[__index]; }
+
+    const basic_node&
+    operator[](size_type __index) const
+    { return list()[__index]; }
+
+    /**
+     *  @brief Access the value of the dictionary, the missing key is
+     *         inserted with the default value.
+     *  @param __key  Key of the item.
+     */
+    basic_node&
+    operator[](const string_type& __key)
+    { return *insert(__key, basic_node()).first; }
+
+    /**
+     *  @brief Find the value of the dictionary.
+     *  @param __key  Key of the item.
+     *
+     *  Returns `nullptr`, when there is no such key.
+     */
+    basic_node*
+    find(const string_type& __key)
+    {
+        auto __it = _M_lower_bound(__key);
+        if (__it == _M_dict.end() || __it->first != __key) {
+            return nullptr;
+        }
+        return &__it->second;
+    }
+
+    const basic_node*
+    find(const string_type& __key) const
+    { return const_cast<basic_node*>(this)->find(__key); }
+
+    /**
+     *  @brief Insert the item into the dictionary, if there is no item
+     *         with the same key.
+     *  @param __key    Key of the item.
+     *  @param __value  Value of the item.
+     *
+     *  Returns a pair of the pointer to the value with the key and the
+     *  flag, whether the item was inserted.
+     */
+    std::pair<basic_node*, bool>
+    insert(string_type __key, basic_node __value)
+    {
+        auto __it = _M_lower_bound(__key);
+        if (__it != _M_dict.end() && __it->first == __key) {
+            return std::make_pair(&__it->second, false);
+        }
+
+        __it = _M_dict.emplace(__it, std::move(__key), std::move(__value));
+        return std::make_pair(&__it->second, true);
+    }
+
+    /**
+     *  @brief Add the element to the end of the list.
+     *  @param __value  Element to add.
+     */
+    void
+    push_back(basic_node __value)
+    { list().push_back(std::move(__value)); }
+
+    /**
+     *  @brief Serialize the node to the specified output stream.
+     *  @param __s  Reference to the output stream.
+     */
+    void
+    dump(std::basic_ostream<CharT, Traits>& __s) const
+    {
+        switch (_M_type)
+        {
+        case node_type::integer:
+            __s << basic_value_type::integer_token << _M_integer
+                << basic_value_type::end_token;
+            break;
+        case node_type::string:
+            _M_dump_string(__s, _M_string);
+            break;
+        case node_type::list:
+            __s << basic_value_type::list_token;
+            for (auto& __value : _M_list) {
+                __value.dump(__s);
+            }
+            __s << basic_value_type::end_token;
+            break;
+        case node_type::dict:
+            __s << basic_value_type::dict_token;
+            for (auto& __item : _M_dict) {
+                _M_dump_string(__s, __item.first);
+                __s << basic_value_type::delimiter_token;
+                __item.second.dump(__s);
+            }
+            __s << basic_value_type::end_token;
+            break;
+        }
+    }
+
+    /**
+     *  @brief Convert the node into the value of the class hierarchy.
+     *
+     *  Returns a shared pointer of the base value class with the copy of
+     *  the node.
+     */
+    value_ptr_type
+    to_value() const
+    {
+        switch (_M_type)
+        {
+        case node_type::integer:
+            return make_integer<CharT, IntT, Traits>(_M_integer);
+        case node_type::string:
+            return make_string<CharT, Traits>(_M_string);
+        case node_type::list: {
+            auto __ptr = std::make_shared<basic_list<CharT, IntT, Traits>>();
+            for (auto& __value : _M_list) {
+                __ptr->insert(__value.to_value());
+            }
+            return __ptr;
+        }
+        default: {
+            using dict_type = basic_dict<CharT, IntT, Traits>;
+
+            auto __ptr = std::make_shared<dict_type>();
+            for (auto& __item : _M_dict) {
+                __ptr->insert(typename dict_type::value_type(
+                    basic_string<CharT, Traits>(__item.first),
+                    __item.second.to_value()));
+            }
+            return __ptr;
+        }
+        }
+    }
+
+    bool
+    operator==(const basic_node& __n) const
+    {
+        if (_M_type != __n._M_type) {
+            return false;
+        }
+
+        switch (_M_type)
+        {
+        case node_type::integer:
+            return _M_integer == __n._M_integer;
+        case node_type::string:
+            return _M_string == __n._M_string;
+        case node_type::list:
+            return _M_list == __n._M_list;
+        default:
+            return _M_dict == __n._M_dict;
+        }
+    }
+
+    bool
+    operator!=(const basic_node& __n) const
+    { return !(*this == __n); }
+
+private:
+    void
+    _M_check(node_type __type, const char* __what) const
+    {
+        if (_M_type != __type) {
+            __bencode_throw(type_error(std::string("bencode::node the "
+                "value is not ") + __what + "\n"));
+        }
+    }
+
+    typename dict_type::iterator
+    _M_lower_bound(const string_type& __key)
+    {
+        auto& __dict = dict();
+
+        // The items are usually appended in the sorted order.
+        if (__dict.empty() || __dict.back().first < __key) {
+            return __dict.end();
+        }
+
+        return std::lower_bound(__dict.begin(), __dict.end(), __key,
+            [](const item_type& __item, const string_type& __k) {
+                return __item.first < __k;
+            });
+    }
+
+    static void
+    _M_dump_string(std::basic_ostream<CharT, Traits>& __s,
+        const string_type& __str)
+    {
+        __s << __str.size() << basic_value_type::delimiter_token;
+        __s.write(__str.data(), __str.size());
+    }
+
+    // Construct the value from the node of the same type, the node
+    // should be destroyed or freshly constructed.
+    template <typename Node>
+    void
+    _M_construct(Node&& __n)
+    {
+        switch (__n._M_type)
+        {
+        case node_type::integer:
+            _M_integer = __n._M_integer;
+            break;
+        case node_type::string:
+            new (&_M_string) string_type(
+                std::forward<Node>(__n)._M_string);
+            break;
+        case node_type::list:
+            new (&_M_list) list_type(std::forward<Node>(__n)._M_list);
+            break;
+        case node_type::dict:
+            new (&_M_dict) dict_type(std::forward<Node>(__n)._M_dict);
+            break;
+        }
+        _M_type = __n._M_type;
+    }
+
+    void
+    _M_destroy() noexcept
+    {
+        switch (_M_type)
+        {
+        case node_type::string:
+            _M_string.~string_type();
+            break;
+        case node_type::list:
+            _M_list.~list_type();
+            break;
+        case node_type::dict:
+            _M_dict.~dict_type();
+            break;
+        default:
+            break;
+        }
+        _M_type = node_type::integer;
+    }
+
+    void
+    _M_from_value(const value_ptr_type& __ptr)
+    {
+        using integer_value = basic_integer<CharT, IntT, Traits>;
+        using string_value = basic_string<CharT, Traits>;
+        using list_value = basic_list<CharT, IntT, Traits>;
+        using dict_value = basic_dict<CharT, IntT, Traits>;
+
+        if (auto __i = std::dynamic_pointer_cast<integer_value>(__ptr)) {
+            *this = basic_node(IntT(*__i));
+        } else if (auto __s = std::dynamic_pointer_cast<string_value>(
+                __ptr)) {
+            *this = basic_node(string_type(*__s));
+        } else if (auto __l = std::dynamic_pointer_cast<list_value>(
+                __ptr)) {
+            list_type __list;
+            for (auto& __value : *__l) {
+                __list.push_back(basic_node(__value));
+            }
+            *this = basic_node(std::move(__list));
+        } else if (auto __d = std::dynamic_pointer_cast<dict_value>(
+                __ptr)) {
+            *this = basic_node(dict_type());
+            for (auto& __item : *__d) {
+                if (__item.second) {
+                    insert(string_type(__item.first),
+                        basic_node(__item.second));
+                }
+            }
+        } else {
+            __bencode_throw(type_error("bencode::node the value has an "
+                "unsupported type\n"));
+        }
+    }
+
+    node_type _M_type;
+
+    union {
+        integer_type _M_integer;
+        string_type _M_string;
+        list_type _M_list;
+        dict_type _M_dict;
+    };
+};
+
+
+namespace __detail
+{
+
+
+// Build the node from the range, which is already validated. The nesting
+// is tracked on the explicit stack of the pointers to the containers,
+// which stay valid, since only the innermost container is modified.
+template <typename CharT, typename IntT, typename Traits>
+void
+__build_node(const CharT* __p, const CharT* __last,
+    basic_node<CharT, IntT, Traits>& __root)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+    using node_type = basic_node<CharT, IntT, Traits>;
+    using string_type = typename node_type::string_type;
+
+    auto __chars = [&__p]() {
+        std::size_t __length = 0;
+        for (; *__p != basic_value_type::delimiter_token; ++__p) {
+            __length = __length * 10 + std::size_t(*__p - CharT('0'));
+        }
+        string_type __s(++__p, __length);
+        __p += __length;
+        return __s;
+    };
+
+    __skip_handler<CharT, IntT> __skip;
+    std::vector<node_type*> __stack;
+    string_type __key;
+    bool __has_key = false;
+
+    for (;;) {
+        auto __ch = *__p;
+        node_type* __slot = &__root;
+
+        if (!__stack.empty()) {
+            auto __top = __stack.back();
+
+            if (__ch == basic_value_type::end_token) {
+                ++__p;
+                __stack.pop_back();
+                if (__stack.empty()) {
+                    return;
+                }
+                continue;
+            }
+
+            if (__top->is_dict() && !__has_key) {
+                __key = __chars();
+                __has_key = true;
+                ++__p;
+                continue;
+            }
+
+            if (__top->is_list()) {
+                __top->list().emplace_back();
+                __slot = &__top->list().back();
+            } else {
+                auto __r = __top->insert(std::move(__key), node_type());
+                __has_key = false;
+
+                // The first value of the duplicate key is kept.
+                if (!__r.second) {
+                    __p = __walk_structure<CharT, IntT, Traits>(
+                        __p, __p, __last, __skip, "bencode::parse_node");
+                    continue;
+                }
+                __slot = __r.first;
+            }
+        }
+
+        if (__ch == basic_value_type::integer_token) {
+            auto __digits = ++__p;
+            while (*__p != basic_value_type::end_token) {
+                ++__p;
+            }
+
+            IntT __i = 0;
+            decode_integer(__digits, __p++, __i);
+            *__slot = node_type(__i);
+        } else if (__ch == basic_value_type::list_token) {
+            *__slot = node_type(typename node_type::list_type());
+            __stack.push_back(__slot);
+            ++__p;
+        } else if (__ch == basic_value_type::dict_token) {
+            *__slot = node_type(typename node_type::dict_type());
+            __stack.push_back(__slot);
+            ++__p;
+        } else {
+            *__slot = node_type(__chars());
+        }
+
+        if (__stack.empty()) {
+            return;
+        }
+    }
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Parse bencoded value into the node.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s   Start of the range.
+ *  @param __n   Count of characters in the range.
+ *  @param __ec  Error code, which is cleared on success.
+ *
+ *  The first value of the range is validated and decoded. Returns a pair
+ *  of the node and the count of characters consumed from the range. On
+ *  error the node is the default one and the second element is the offset
+ *  of the error.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::pair<basic_node<CharT, IntT, Traits>, std::size_t>
+parse_node(const CharT* __s, std::size_t __n, std::error_code& __ec)
+{
+    __detail::__validate_handler __handler;
+    auto __r = __detail::__validate<CharT, IntT, Traits>(
+        __s, __n, 512, __handler);
+
+    // The value is complete, when only the trailing symbols are left.
+    if (__r.code == errc::trailing_data) {
+        __r.code = errc::success;
+    }
+
+    basic_node<CharT, IntT, Traits> __node;
+    if (__r) {
+        __detail::__build_node(__s, __s + __n, __node);
+    }
+
+    __ec = make_error_code(__r.code);
+    return std::make_pair(std::move(__node), __r.offset);
+}
+
+
+/**
+ *  @brief Parse bencoded value into the node.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s  Start of the range.
+ *  @param __n  Count of characters in the range.
+ *
+ *  Returns a pair of the node and the count of characters consumed from
+ *  the range. Throws `encoding_error` on malformed input.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::pair<basic_node<CharT, IntT, Traits>, std::size_t>
+parse_node(const CharT* __s, std::size_t __n)
+{
+    std::error_code __ec;
+    auto __r = parse_node<CharT, IntT, Traits>(__s, __n, __ec);
+    if (__ec) {
+        std::ostringstream __error;
+
+        __error << "bencode::parse_node " << __ec.message()
+            << " at offset " << __r.second << "\n";
+        __bencode_throw(encoding_error(__error.str()));
+    }
+    return __r;
+}
+
+
+typedef basic_node<char> node;
+
+
+typedef basic_node<wchar_t> wnode;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_node_hpp__
@@ -0,0 +1,922 @@
+#ifndef INCLUDE_bencode_parallel_hpp__
+#define INCLUDE_bencode_parallel_hpp__
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <bencode/arena.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/skip.hpp>
+#include <bencode/string.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Location of the value in the concatenation of the values.
+ */
+struct value_span
+{
+    std::size_t offset;
+    std::size_t length;
+
+    // The description of the error, it is empty for the valid values.
+    std::string error;
+
+    /**
+     *  @brief Check whether the span contains the valid value.
+     */
+    bool
+    valid() const
+    { return error.empty(); }
+};
+
+
+/**
+ *  @brief Options of the parallel decoding.
+ */
+struct parallel_options
+{
+    /**
+     *  @brief Count of the worker threads, zero selects the count of
+     *         the hardware threads.
+     */
+    std::size_t threads = 0;
+
+    /**
+     *  @brief Deliver the results in the order of the values.
+     */
+    bool ordered = true;
+
+    /**
+     *  @brief Continue after the corrupt value from the next position,
+     *         where the valid value starts.
+     */
+    bool resync = true;
+
+    /**
+     *  @brief Minimal count of characters of the container, which
+     *         elements are decoded in parallel by `parallel_parse`.
+     */
+    std::size_t threshold = 1 << 20;
+
+    /**
+     *  @brief Maximal nesting of the containers, which elements are
+     *         decoded in parallel by `parallel_parse`. The deeper
+     *         containers are decoded sequentially.
+     */
+    std::size_t plan_depth = 64;
+};
+
+
+/**
+ *  @brief Template struct basic_record.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  The result of decoding of the single value from the concatenation.
+ */
+template
+< typename CharT = char
+, typename Traits = std::char_traits<CharT>
+> struct basic_record
+{
+    std::size_t index;
+    std::size_t offset;
+    std::size_t length;
+
+    // The decoded value, it is `nullptr` for the corrupt values.
+    std::shared_ptr<basic_value<CharT, Traits>> value;
+
+    // The description of the error, it is empty for the valid values.
+    std::string error;
+
+    /**
+     *  @brief Check whether the value was decoded.
+     */
+    bool
+    ok() const
+    { return value != nullptr; }
+};
+
+
+/**
+ *  @brief Template struct basic_batch_result.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  The results of decoding of the batch of the independent values.
+ */
+template
+< typename CharT = char
+, typename Traits = std::char_traits<CharT>
+> struct basic_batch_result
+{
+    // The scratch memory of the workers, which keeps the values decoded
+    // with the `arena_allocator`. The values should not outlive it.
+    std::vector<std::shared_ptr<monotonic_arena>> arenas;
+
+    // The records in the order of the buffers.
+    std::vector<basic_record<CharT, Traits>> records;
+
+    // The count of the records, which failed to decode.
+    std::size_t errors = 0;
+
+    // The count of characters consumed by the decoded records.
+    std::size_t characters = 0;
+
+    // The wall time of the decoding.
+    std::chrono::duration<double> elapsed{0};
+
+    /**
+     *  @brief Returns the count of the decoded characters per second.
+     */
+    double
+    throughput() const
+    {
+        auto __seconds = elapsed.count();
+        return __seconds > 0 ? characters / __seconds : 0;
+    }
+};
+
+
+namespace __detail
+{
+
+
+// Returns the count of the worker threads to run for the count of jobs.
+inline std::size_t
+__worker_count(std::size_t __threads, std::size_t __jobs)
+{
+    if (!__threads) {
+        __threads = std::max<std::size_t>(
+            std::thread::hardware_concurrency(), 1);
+    }
+    return std::min(__threads, __jobs);
+}
+
+
+// Set of the running worker threads, which are stopped and joined on
+// destruction, so the workers never outlive the state they refer to.
+class __worker_group
+{
+public:
+    explicit
+    __worker_group(std::atomic<bool>& __stop)
+    : _M_stop(__stop)
+    { }
+
+    __worker_group(const __worker_group&) = delete;
+
+    __worker_group&
+    operator=(const __worker_group&) = delete;
+
+    ~__worker_group()
+    {
+        _M_stop = true;
+        join();
+    }
+
+    template <typename Function>
+    void
+    spawn(Function __f)
+    { _M_threads.emplace_back(std::move(__f)); }
+
+    void
+    join()
+    {
+        for (auto& __t : _M_threads) {
+            if (__t.joinable()) {
+                __t.join();
+            }
+        }
+    }
+
+private:
+    std::atomic<bool>& _M_stop;
+    std::vector<std::thread> _M_threads;
+};
+
+
+// Call the function for each index of the range by the worker threads,
+// the indices are claimed in the chunks of the specified size. Besides
+// the index, the function receives the number of the calling worker,
+// which is less than the `__worker_count` of the chunks. The first
+// exception thrown by the function is rethrown after all workers stop.
+template <typename Function>
+void
+__parallel_for_workers(std::size_t __count, std::size_t __threads,
+    std::size_t __chunk, Function __f)
+{
+    std::atomic<std::size_t> __next(0);
+    std::atomic<bool> __stop(false);
+    std::exception_ptr __error;
+    std::mutex __mutex;
+
+    auto __worker = [&](std::size_t __w) {
+        while (!__stop) {
+            auto __first = __next.fetch_add(__chunk);
+            if (__first >= __count) {
+                return;
+            }
+
+            auto __last = std::min(__first + __chunk, __count);
+            try {
+                for (auto __i = __first; __i < __last; ++__i) {
+                    __f(__w, __i);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> __lock(__mutex);
+                if (!__error) {
+                    __error = std::current_exception();
+                }
+                __stop = true;
+            }
+        }
+    };
+
+    {
+        __worker_group __workers(__stop);
+        auto __n = __worker_count(__threads, (__count + __chunk - 1) / __chunk);
+        for (std::size_t __i = 0; __i < __n; ++__i) {
+            __workers.spawn([&__worker, __i]() { __worker(__i); });
+        }
+        __workers.join();
+    }
+
+    if (__error) {
+        std::rethrow_exception(__error);
+    }
+}
+
+
+// Call the function for each index of the range by the worker threads.
+template <typename Function>
+void
+__parallel_for(std::size_t __count, std::size_t __threads,
+    std::size_t __chunk, Function __f)
+{
+    __parallel_for_workers(__count, __threads, __chunk,
+        [&__f](std::size_t, std::size_t __i) { __f(__i); });
+}
+
+
+// Element of the large container, which is decoded by the worker thread
+// into the pre-allocated slot of the container.
+template <typename ValuePtr, typename CharT>
+struct __parallel_job
+{
+    ValuePtr* _M_slot;
+    const CharT* _M_first;
+    std::size_t _M_length;
+};
+
+
+// Element of the planned container: the key of the dictionary item and
+// the range of the value. The elements, which are planned containers
+// themselves, refer to their entries of the plan.
+template <typename CharT>
+struct __plan_item
+{
+    const CharT* _M_key;
+    std::size_t _M_key_length;
+    std::size_t _M_token;
+    std::size_t _M_first;
+    std::size_t _M_length;
+    std::size_t _M_entry;
+};
+
+
+// Container, which elements are decoded in parallel.
+template <typename CharT>
+struct __plan_entry
+{
+    std::size_t _M_first;
+    std::vector<__plan_item<CharT>> _M_items;
+};
+
+
+// Handler of the structure walk, which finds the containers of at least
+// the threshold characters together with the boundaries of their elements
+// in a single pass. Only the containers up to the maximal depth are
+// tracked, the deeper ones are decoded sequentially as the elements.
+template <typename CharT, typename IntT>
+class __plan_handler
+{
+public:
+    static const std::size_t npos = std::size_t(-1);
+
+    __plan_handler(const CharT* __begin, std::size_t __threshold,
+        std::size_t __max_depth)
+    : _M_begin(__begin), _M_threshold(__threshold)
+    , _M_max_depth(__max_depth), _M_depth(0), _M_open(0), _M_root(npos)
+    { }
+
+    void
+    integer(const CharT* __token, IntT)
+    { _M_value(__token); }
+
+    void
+    string(const CharT* __token, const CharT*, std::size_t)
+    { _M_value(__token); }
+
+    void
+    key(const CharT* __token, const CharT* __key, std::size_t __length)
+    {
+        if (_M_depth && _M_depth == _M_open) {
+            auto __pos = std::size_t(__token - _M_begin);
+            _M_frames[_M_open-1]._M_items.push_back(
+                {__key, __length, __pos, 0, 0, npos});
+        }
+    }
+
+    void
+    begin_list(const CharT* __token)
+    { _M_begin_container(__token, false); }
+
+    void
+    begin_dict(const CharT* __token)
+    { _M_begin_container(__token, true); }
+
+    void
+    end_list(const CharT* __token)
+    { _M_end_container(__token); }
+
+    void
+    end_dict(const CharT* __token)
+    { _M_end_container(__token); }
+
+    // Returns the entry of the value, or `npos` when it is decoded
+    // sequentially.
+    std::size_t
+    root() const
+    { return _M_root; }
+
+    const std::vector<__plan_entry<CharT>>&
+    entries() const
+    { return _M_entries; }
+
+private:
+    struct __frame
+    {
+        std::size_t _M_first;
+        bool _M_dict;
+        std::vector<__plan_item<CharT>> _M_items;
+    };
+
+    // Record the start of the element of the tracked container.
+    void
+    _M_value(const CharT* __token)
+    {
+        if (!_M_depth || _M_depth != _M_open) {
+            return;
+        }
+
+        auto& __f = _M_frames[_M_open-1];
+        auto __pos = std::size_t(__token - _M_begin);
+
+        if (__f._M_dict) {
+            __f._M_items.back()._M_first = __pos;
+        } else {
+            __f._M_items.push_back({nullptr, 0, __pos, __pos, 0, npos});
+        }
+    }
+
+    void
+    _M_begin_container(const CharT* __token, bool __dict)
+    {
+        _M_value(__token);
+
+        if (_M_depth++ != _M_open || _M_open == _M_max_depth) {
+            return;
+        }
+
+        // The frames are reused, so the storage of the elements is
+        // allocated only for the first containers at each depth.
+        if (_M_frames.size() == _M_open) {
+            _M_frames.emplace_back();
+        }
+
+        auto& __f = _M_frames[_M_open++];
+        __f._M_first = std::size_t(__token - _M_begin);
+        __f._M_dict = __dict;
+        __f._M_items.clear();
+    }
+
+    void
+    _M_end_container(const CharT* __token)
+    {
+        if (_M_depth-- != _M_open) {
+            return;
+        }
+
+        auto& __f = _M_frames[--_M_open];
+        auto __end = std::size_t(__token - _M_begin);
+
+        if (__end + 1 - __f._M_first < _M_threshold) {
+            return;
+        }
+
+        // Each element spans up to the start of the next one.
+        auto& __items = __f._M_items;
+        for (std::size_t __i = 0; __i < __items.size(); ++__i) {
+            auto __last = __i + 1 < __items.size() ?
+                __items[__i+1]._M_token : __end;
+            __items[__i]._M_length = __last - __items[__i]._M_first;
+        }
+
+        auto __index = _M_entries.size();
+        _M_entries.push_back({__f._M_first, std::move(__items)});
+
+        if (_M_open) {
+            _M_frames[_M_open-1]._M_items.back()._M_entry = __index;
+        } else {
+            _M_root = __index;
+        }
+    }
+
+    const CharT* _M_begin;
+    std::size_t _M_threshold;
+    std::size_t _M_max_depth;
+    std::size_t _M_depth;
+    std::size_t _M_open;
+    std::size_t _M_root;
+    std::vector<__frame> _M_frames;
+    std::vector<__plan_entry<CharT>> _M_entries;
+};
+
+
+// Create the containers of the plan starting from the specified entry,
+// and schedule the decoding of their other elements. The containers are
+// created from the worklist, so the nesting does not grow the stack.
+template<__bencode_dict_template>
+std::shared_ptr<basic_value<CharT, Traits>>
+__build_plan(const CharT* __s,
+    const std::vector<__plan_entry<CharT>>& __entries, std::size_t __root,
+    std::vector<__parallel_job<
+        std::shared_ptr<basic_value<CharT, Traits>>, CharT>>& __jobs)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+    using list_type = basic_list<__bencode_list_typenames>;
+    using dict_type = basic_dict<__bencode_dict_typenames>;
+    using key_type = basic_string<__bencode_string_typenames>;
+
+    // Created container, which elements are not assigned yet.
+    struct __pending
+    {
+        std::size_t _M_entry;
+        list_type* _M_list;
+        dict_type* _M_dict;
+    };
+
+    std::vector<__pending> __worklist;
+
+    auto __create = [&](std::size_t __entry) -> value_ptr_type {
+        auto& __e = __entries[__entry];
+
+        // The slots of the list are allocated at once, so the references
+        // to them stay valid while the elements are decoded.
+        if (__s[__e._M_first] == basic_value_type::list_token) {
+            auto __list = __allocate_value<list_type, Allocator>(
+                __e._M_items.size());
+            __worklist.push_back({__entry, __list.get(), nullptr});
+            return __list;
+        }
+
+        auto __dict = __allocate_value<dict_type, Allocator>();
+        __worklist.push_back({__entry, nullptr, __dict.get()});
+        return __dict;
+    };
+
+    auto __assign = [&](value_ptr_type& __slot,
+            const __plan_item<CharT>& __item) {
+        if (__item._M_entry != __plan_handler<CharT, IntT>::npos) {
+            __slot = __create(__item._M_entry);
+        } else {
+            __jobs.push_back({&__slot, __s + __item._M_first,
+                __item._M_length});
+        }
+    };
+
+    auto __value = __create(__root);
+
+    while (!__worklist.empty()) {
+        auto __p = __worklist.back();
+        __worklist.pop_back();
+
+        auto& __items = __entries[__p._M_entry]._M_items;
+        if (__p._M_list) {
+            for (std::size_t __i = 0; __i < __items.size(); ++__i) {
+                __assign((*__p._M_list)[__i], __items[__i]);
+            }
+            continue;
+        }
+
+        // The first value of the duplicate key is kept, the same as the
+        // sequential decoding does.
+        for (auto& __item : __items) {
+            auto __it = __p._M_dict->insert(std::make_pair(
+                key_type(__item._M_key, __item._M_key_length), nullptr));
+            if (__it.second) {
+                __assign(__it.first->second, __item);
+            }
+        }
+    }
+    return __value;
+}
+
+
+// Check that the container at the start of the range could begin the
+// record: it is not empty, it is valid and it is followed by the end of
+// the range or by the start of the next value.
+template <typename CharT, typename IntT, typename Traits>
+bool
+__is_resync_point(const CharT* __s, std::size_t __n)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    if (__n < 2 || __s[1] == basic_value_type::end_token) {
+        return false;
+    }
+
+    std::size_t __length = 0;
+    try {
+        __length = skip_value<CharT, IntT, Traits>(__s, __n);
+    } catch (const encoding_error&) {
+        return false;
+    }
+
+    if (__length == __n) {
+        return true;
+    }
+
+    auto __ch = __s[__length];
+    return __ch == basic_value_type::dict_token ||
+        __ch == basic_value_type::list_token ||
+        __ch == basic_value_type::integer_token ||
+        (__ch >= CharT('0') && __ch <= CharT('9'));
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Find the boundaries of the concatenated values.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s       Start of the range.
+ *  @param __n       Count of characters in the range.
+ *  @param __resync  Continue after the corrupt value.
+ *
+ *  The values are skipped without decoding. When the value is corrupt
+ *  and @a __resync is True, the scan continues from the next list or
+ *  dictionary token, which starts the valid non-empty value followed by
+ *  the end of the range or the start of another value, and the symbols
+ *  in between are reported as the invalid span. Otherwise the rest of
+ *  the range is reported as the invalid span.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::vector<value_span>
+split_values(const CharT* __s, std::size_t __n, bool __resync = true)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    std::vector<value_span> __spans;
+    std::size_t __pos = 0;
+
+    while (__pos < __n) {
+        try {
+            auto __length = __detail::__skip_value<CharT, IntT, Traits>(
+                __s + __pos, __n - __pos, "bencode::split_values");
+            __spans.push_back(value_span{__pos, __length, std::string()});
+            __pos += __length;
+            continue;
+        } catch (const encoding_error& __e) {
+            value_span __span{__pos, __n - __pos, __e.what()};
+
+            // Look for the next container, which could be skipped.
+            for (auto __next = __pos + 1; __resync && __next < __n;
+                    ++__next) {
+                auto __ch = __s[__next];
+                if (__ch != basic_value_type::dict_token &&
+                        __ch != basic_value_type::list_token) {
+                    continue;
+                }
+
+                // The tokens within the string payloads could look like
+                // the short containers, for example the `de` in the key
+                // `nodes`, so the resynchronization point is taken only
+                // when it lines up with the record boundaries.
+                if (!__detail::__is_resync_point<CharT, IntT, Traits>(
+                        __s + __next, __n - __next)) {
+                    continue;
+                }
+
+                __span.length = __next - __pos;
+                break;
+            }
+
+            __pos += __span.length;
+            __spans.push_back(std::move(__span));
+        }
+    }
+
+    return __spans;
+}
+
+
+/**
+ *  @brief Decode the concatenated values in parallel.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam Callback       Callback type.
+ *
+ *  @param __s         Start of the range.
+ *  @param __n         Count of characters in the range.
+ *  @param __callback  Callback receiving the `basic_record` instances.
+ *  @param __options   Options of the decoding.
+ *
+ *  At first, the boundaries of the values are found with `split_values`,
+ *  then the values are decoded by the pool of worker threads. The
+ *  callback is always called from the calling thread, either in the order
+ *  of the values or in the order of completion. The corrupt values are
+ *  reported with the error instead of the value. Returns the count of
+ *  the delivered records.
+ */
+template<__bencode_dict_template, typename Callback>
+std::size_t
+parallel_decode(const CharT* __s, std::size_t __n, Callback __callback,
+    const parallel_options& __options = parallel_options())
+{
+    using record_type = basic_record<CharT, Traits>;
+
+    auto __spans = split_values<CharT, IntT, Traits>(
+        __s, __n, __options.resync);
+    auto __count = __spans.size();
+
+    std::vector<record_type> __records(__count);
+    std::vector<bool> __ready(__count);
+    std::deque<std::size_t> __completed;
+
+    std::mutex __mutex;
+    std::condition_variable __cond;
+    std::atomic<std::size_t> __next(0);
+    std::atomic<bool> __stop(false);
+
+    auto __worker = [&]() {
+        for (;;) {
+            auto __index = __next++;
+            if (__stop || __index >= __count) {
+                return;
+            }
+
+            auto& __span = __spans[__index];
+            auto& __record = __records[__index];
+
+            __record.index = __index;
+            __record.offset = __span.offset;
+            __record.length = __span.length;
+            __record.error = __span.error;
+
+            if (__span.valid()) {
+                try {
+                    __record.value = parse<__bencode_dict_typenames>(
+                        __s + __span.offset, __span.length).first;
+                } catch (const std::exception& __e) {
+                    __record.error = __e.what();
+                }
+            }
+
+            std::lock_guard<std::mutex> __lock(__mutex);
+            __completed.push_back(__index);
+            __cond.notify_one();
+        }
+    };
+
+    __detail::__worker_group __workers(__stop);
+    auto __threads = __detail::__worker_count(__options.threads, __count);
+    for (std::size_t __i = 0; __i < __threads; ++__i) {
+        __workers.spawn(__worker);
+    }
+
+    std::size_t __delivered = 0;
+    std::size_t __ordered = 0;
+
+    while (__delivered < __count) {
+        std::unique_lock<std::mutex> __lock(__mutex);
+        __cond.wait(__lock, [&]() { return !__completed.empty(); });
+
+        auto __index = __completed.front();
+        __completed.pop_front();
+        __lock.unlock();
+
+        if (!__options.ordered) {
+            __callback(std::move(__records[__index]));
+            ++__delivered;
+            continue;
+        }
+
+        // Keep the completed records until all the preceding records
+        // are delivered.
+        __ready[__index] = true;
+        for (; __ordered < __count && __ready[__ordered]; ++__ordered) {
+            __callback(std::move(__records[__ordered]));
+            ++__delivered;
+        }
+    }
+
+    return __delivered;
+}
+
+
+/**
+ *  @brief Parse bencoded value decoding the large containers in parallel.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  @param __s        Start of the range.
+ *  @param __n        Count of characters in the range.
+ *  @param __options  Options of the decoding.
+ *
+ *  The value is decoded with `parse`, unless it is a container of at
+ *  least `threshold` characters. The elements of such containers are
+ *  located with a single skip-only pass and decoded by the pool of
+ *  worker threads, then assembled in the original order. Only the
+ *  containers nested up to `plan_depth` are split into the elements. Returns a pair of the
+ *  shared pointer to the decoded value and the count of characters
+ *  consumed from the range.
+ */
+template<__bencode_dict_template>
+std::pair<std::shared_ptr<basic_value<CharT, Traits>>, std::size_t>
+parallel_parse(const CharT* __s, std::size_t __n,
+    const parallel_options& __options = parallel_options())
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    // The boundary pass validates the whole value and records the
+    // elements of the large containers, so each element is scanned
+    // only once.
+    __detail::__plan_handler<CharT, IntT> __plan(__s, __options.threshold,
+        __options.plan_depth);
+    auto __end = __detail::__walk_structure<CharT, IntT, Traits>(
+        __s, __s + __n, __plan, "bencode::parallel_parse");
+    auto __length = std::size_t(__end - __s);
+
+    if (__plan.root() == __plan.npos) {
+        return parse<__bencode_dict_typenames>(__s, __n);
+    }
+
+    std::vector<__detail::__parallel_job<value_ptr_type, CharT>> __jobs;
+    auto __ptr = __detail::__build_plan<__bencode_dict_typenames>(
+        __s, __plan.entries(), __plan.root(), __jobs);
+
+    __detail::__parallel_for(__jobs.size(), __options.threads, 64,
+        [&](std::size_t __i) {
+            auto& __job = __jobs[__i];
+            *__job._M_slot = parse<__bencode_dict_typenames>(
+                __job._M_first, __job._M_length).first;
+        });
+
+    return std::make_pair(__ptr, __length);
+}
+
+
+/**
+ *  @brief Decode the batch of the independent values in parallel.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam Buffers        Container of the buffers, each providing the
+ *                         `data()` and `size()` methods.
+ *
+ *  @param __buffers  Buffers to decode.
+ *  @param __options  Options of the decoding, only the count of threads
+ *                    is used.
+ *
+ *  The first value of each buffer is decoded by the bounded pool of
+ *  worker threads. The errors are reported in the records of the
+ *  failed buffers, so a single malformed buffer does not interrupt the
+ *  batch. Returns the records in the order of the buffers together with
+ *  the aggregate statistics.
+ *
+ *  With the `arena_allocator`, each worker decodes the values into its
+ *  own `monotonic_arena`, so the workers do not contend for the global
+ *  heap. The arenas are kept by the result, and the decoded values
+ *  should be destroyed before it.
+ */
+template<__bencode_dict_template, typename Buffers>
+basic_batch_result<CharT, Traits>
+decode_batch(const Buffers& __buffers,
+    const parallel_options& __options = parallel_options())
+{
+    using clock_type = std::chrono::steady_clock;
+
+    basic_batch_result<CharT, Traits> __result;
+    auto& __records = __result.records;
+
+    std::vector<std::pair<const CharT*, std::size_t>> __ranges;
+    for (const auto& __buf : __buffers) {
+        __ranges.emplace_back(__buf.data(), __buf.size());
+    }
+    __records.resize(__ranges.size());
+
+    const std::size_t __chunk = 16;
+    auto __threads = __detail::__worker_count(__options.threads,
+        (__ranges.size() + __chunk - 1) / __chunk);
+
+    if (std::is_same<Allocator<CharT>, arena_allocator<CharT>>::value) {
+        for (std::size_t __w = 0; __w < __threads; ++__w) {
+            __result.arenas.push_back(std::make_shared<monotonic_arena>());
+        }
+    }
+
+    auto __decode = [&](std::size_t __i) {
+        auto& __record = __records[__i];
+
+        __record.index = __i;
+        __record.offset = 0;
+        __record.length = 0;
+
+        try {
+            auto __r = parse<__bencode_dict_typenames>(
+                __ranges[__i].first, __ranges[__i].second);
+            __record.value = __r.first;
+            __record.length = __r.second;
+        } catch (const std::exception& __e) {
+            __record.error = __e.what();
+        }
+    };
+
+    auto __start = clock_type::now();
+
+    __detail::__parallel_for_workers(__ranges.size(), __threads, __chunk,
+        [&](std::size_t __w, std::size_t __i) {
+            if (__result.arenas.empty()) {
+                __decode(__i);
+            } else {
+                arena_scope __scope(*__result.arenas[__w]);
+                __decode(__i);
+            }
+        });
+
+    __result.elapsed = clock_type::now() - __start;
+
+    for (const auto& __record : __records) {
+        __result.characters += __record.length;
+        __result.errors += !__record.ok();
+    }
+    return __result;
+}
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_parallel_hpp__
@@ -0,0 +1,559 @@
+#ifndef INCLUDE_bencode_pool_hpp__
+#define INCLUDE_bencode_pool_hpp__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <bencode/algorithm.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/error.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/skip.hpp>
+#include <bencode/string.hpp>
+#include <bencode/validate.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+namespace __detail
+{
+
+
+// Handler of the validation, which computes the hash of the keys of the
+// dictionaries together with their nesting levels. The messages of the
+// same kind usually have the same hash.
+struct __shape_handler
+{
+    std::size_t _M_hash;
+
+    __shape_handler() noexcept
+    : _M_hash(0)
+    { }
+
+    void
+    begin_dict(std::size_t __level) noexcept
+    { _M_hash = _M_hash * 31 + __level + 1; }
+
+    template <typename CharT>
+    errc
+    key(std::size_t __level, const CharT*, const CharT* __key,
+        std::size_t __length) noexcept
+    {
+        _M_hash ^= __level;
+        for (std::size_t __i = 0; __i < __length; ++__i) {
+            _M_hash = (_M_hash ^ std::size_t(__key[__i])) * 1099511628211ull;
+        }
+        return errc::success;
+    }
+};
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Template class basic_node_pool.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  Recycling pool of the values for the repeated decoding of the messages
+ *  of the same shape. The values decoded by the pool are returned back to
+ *  it, when the last shared pointer is released. The containers are kept
+ *  with their items, so the next message of the same shape is decoded
+ *  in place: the keys and the items are reused, the strings keep their
+ *  storage and the unmatched items are removed. The control blocks of the
+ *  shared pointers are recycled too, so the steady decoding of the
+ *  same-shaped messages does not allocate memory.
+ *
+ *  The pool is not thread-safe and should outlive the values it decoded.
+ */
+template<__bencode_dict_template>
+class basic_node_pool
+{
+public:
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    using integer_type = basic_integer<__bencode_integer_typenames>;
+
+    using string_type = basic_string<__bencode_string_typenames>;
+
+    using list_type = basic_list<__bencode_list_typenames>;
+
+    using dict_type = basic_dict<__bencode_dict_typenames>;
+
+    using size_type = std::size_t;
+
+    // The default count of the cached values of each type.
+    static const size_type default_capacity = 1024;
+
+    /**
+     *  @brief Construct an empty pool.
+     *  @param __capacity  Maximum count of the cached values of each type.
+     */
+    explicit
+    basic_node_pool(size_type __capacity = default_capacity)
+    : _M_capacity(__capacity)
+    {
+        // The caches never grow, so the values are returned to the pool
+        // without memory allocation.
+        _M_integers.reserve(__capacity);
+        _M_strings.reserve(__capacity);
+        _M_lists.reserve(__capacity);
+        _M_dicts.reserve(__capacity);
+        _M_blocks.reserve(__capacity * 4);
+    }
+
+    basic_node_pool(const basic_node_pool&) = delete;
+
+    basic_node_pool&
+    operator=(const basic_node_pool&) = delete;
+
+    ~basic_node_pool()
+    { clear(); }
+
+    /**
+     *  @brief Returns the maximum count of the cached values of each type.
+     */
+    size_type
+    capacity() const noexcept
+    { return _M_capacity; }
+
+    /**
+     *  @brief Returns the count of the values kept in the pool.
+     */
+    size_type
+    cached() const noexcept
+    {
+        return _M_integers.size() + _M_strings.size() + _M_lists.size() +
+            _M_dicts.size();
+    }
+
+    /**
+     *  @brief Free all values and memory blocks kept in the pool.
+     */
+    void
+    clear() noexcept
+    {
+        // The values, which are freed, return their items back to the
+        // pool, so they should be deleted right away.
+        auto __capacity = _M_capacity;
+        _M_capacity = 0;
+
+        _M_clear(_M_integers);
+        _M_clear(_M_strings);
+        _M_clear(_M_lists);
+        _M_clear(_M_dicts);
+
+        for (auto __block : _M_blocks) {
+            ::operator delete(__block);
+        }
+        _M_blocks.clear();
+        _M_capacity = __capacity;
+    }
+
+    /**
+     *  @brief Parse bencoded value using the values of the pool.
+     *
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     *
+     *  Returns a pair of the shared pointer to the decoded value and the
+     *  count of characters consumed from the range. The value, which was
+     *  decoded from the message with the same keys, is preferred for the
+     *  reuse. Throws `encoding_error` on malformed input.
+     */
+    std::pair<value_ptr_type, size_type>
+    parse(const CharT* __s, size_type __n)
+    {
+        __detail::__shape_handler __handler;
+        auto __r = __detail::__validate<CharT, IntT, Traits>(
+            __s, __n, 512, __handler);
+
+        // The value is complete, when only the trailing symbols are left.
+        if (__r.code == errc::trailing_data) {
+            __r.code = errc::success;
+        }
+        if (!__r) {
+            std::ostringstream __error;
+
+            __error << "bencode::node_pool::parse "
+                << make_error_code(__r.code).message()
+                << " at offset " << __r.offset << "\n";
+            __bencode_throw(encoding_error(__error.str()));
+        }
+
+        auto __ptr = _M_build(__s, __s + __n, __handler._M_hash);
+        return std::make_pair(__ptr, __r.offset);
+    }
+
+    /**
+     *  @brief Parse bencoded value from the string using the values of
+     *         the pool.
+     *  @param __str  Source string.
+     */
+    template <typename StringAlloc>
+    std::pair<value_ptr_type, size_type>
+    parse(const std::basic_string<CharT, Traits, StringAlloc>& __str)
+    { return parse(__str.data(), __str.size()); }
+
+private:
+    // The size of the recycled memory blocks, which is enough for the
+    // control blocks of the shared pointers.
+    static const size_type _S_block_size = 64;
+
+    template <typename T>
+    struct __cached
+    {
+        size_type _M_shape;
+        T* _M_ptr;
+    };
+
+    // Deleter of the shared pointers, which returns the value back to
+    // the pool.
+    template <typename T>
+    struct __deleter
+    {
+        basic_node_pool* _M_pool;
+        size_type _M_shape;
+
+        void
+        operator()(T* __ptr) const noexcept
+        { _M_pool->_M_release(__ptr, _M_shape); }
+    };
+
+    // Allocator of the control blocks of the shared pointers.
+    template <typename T>
+    struct __block_allocator
+    {
+        using value_type = T;
+
+        template <typename U>
+        struct rebind
+        { using other = __block_allocator<U>; };
+
+        basic_node_pool* _M_pool;
+
+        __block_allocator(basic_node_pool* __pool) noexcept
+        : _M_pool(__pool)
+        { }
+
+        template <typename U>
+        __block_allocator(const __block_allocator<U>& __a) noexcept
+        : _M_pool(__a._M_pool)
+        { }
+
+        T*
+        allocate(size_type __n)
+        { return static_cast<T*>(_M_pool->_M_allocate(__n * sizeof(T))); }
+
+        void
+        deallocate(T* __ptr, size_type __n) noexcept
+        { _M_pool->_M_deallocate(__ptr, __n * sizeof(T)); }
+
+        template <typename U>
+        bool
+        operator==(const __block_allocator<U>& __a) const noexcept
+        { return _M_pool == __a._M_pool; }
+
+        template <typename U>
+        bool
+        operator!=(const __block_allocator<U>& __a) const noexcept
+        { return _M_pool != __a._M_pool; }
+    };
+
+    struct __frame
+    {
+        list_type* _M_list;
+        size_type _M_index;
+        dict_type* _M_dict;
+        typename dict_type::iterator _M_next;
+    };
+
+    std::vector<__cached<integer_type>>&
+    _M_cache(integer_type*) noexcept
+    { return _M_integers; }
+
+    std::vector<__cached<string_type>>&
+    _M_cache(string_type*) noexcept
+    { return _M_strings; }
+
+    std::vector<__cached<list_type>>&
+    _M_cache(list_type*) noexcept
+    { return _M_lists; }
+
+    std::vector<__cached<dict_type>>&
+    _M_cache(dict_type*) noexcept
+    { return _M_dicts; }
+
+    template <typename T>
+    void
+    _M_clear(std::vector<__cached<T>>& __cache) noexcept
+    {
+        while (!__cache.empty()) {
+            auto __ptr = __cache.back()._M_ptr;
+            __cache.pop_back();
+            delete __ptr;
+        }
+    }
+
+    void*
+    _M_allocate(size_type __bytes)
+    {
+        if (__bytes > _S_block_size) {
+            return ::operator new(__bytes);
+        }
+        if (_M_blocks.empty()) {
+            return ::operator new(_S_block_size);
+        }
+
+        auto __block = _M_blocks.back();
+        _M_blocks.pop_back();
+        return __block;
+    }
+
+    void
+    _M_deallocate(void* __block, size_type __bytes) noexcept
+    {
+        if (__bytes <= _S_block_size &&
+                _M_blocks.size() < _M_capacity * 4) {
+            _M_blocks.push_back(__block);
+        } else {
+            ::operator delete(__block);
+        }
+    }
+
+    template <typename T>
+    void
+    _M_release(T* __ptr, size_type __shape) noexcept
+    {
+        auto& __cache = _M_cache(__ptr);
+        if (__cache.size() < _M_capacity) {
+            __cache.push_back(__cached<T>{__shape, __ptr});
+        } else {
+            delete __ptr;
+        }
+    }
+
+    // Return the value of the slot, when it could be modified in place,
+    // otherwise put the value from the pool to the slot. The value with
+    // the same shape is preferred, when the shape is known.
+    template <typename T>
+    T*
+    _M_acquire(value_ptr_type& __slot, size_type __shape)
+    {
+        if (__slot && __slot.use_count() == 1) {
+            if (auto __ptr = dynamic_cast<T*>(__slot.get())) {
+                return __ptr;
+            }
+        }
+
+        T* __ptr = nullptr;
+        auto& __cache = _M_cache(__ptr);
+
+        if (__cache.empty()) {
+            __ptr = new T();
+        } else {
+            auto __it = __cache.end() - 1;
+            for (auto __i = __cache.begin(); __shape && __i != __cache.end();
+                    ++__i) {
+                if (__i->_M_shape == __shape) {
+                    __it = __i;
+                    break;
+                }
+            }
+
+            __ptr = __it->_M_ptr;
+            *__it = __cache.back();
+            __cache.pop_back();
+        }
+
+        __slot = std::shared_ptr<T>(__ptr, __deleter<T>{this, __shape},
+            __block_allocator<T>(this));
+        return __ptr;
+    }
+
+    static bool
+    _M_less(const string_type& __a, const string_type& __b)
+    {
+        return std::lexicographical_compare(__a.cbegin(), __a.cend(),
+            __b.cbegin(), __b.cend());
+    }
+
+    // Find the slot of the key in the dictionary, which is decoded in
+    // place. The items before the next one are already decoded, so the
+    // keys in the sorted order are matched in a single pass, and the
+    // skipped items are removed. Returns `nullptr` for the duplicate key.
+    value_ptr_type*
+    _M_slot(__frame& __f)
+    {
+        auto& __dict = *__f._M_dict;
+        auto __end = __dict.end();
+
+        if (__f._M_next == __dict.begin() ||
+                _M_less(std::prev(__f._M_next)->first, _M_key)) {
+            while (__f._M_next != __end &&
+                    _M_less(__f._M_next->first, _M_key)) {
+                __dict.erase(__f._M_next++);
+            }
+
+            if (__f._M_next != __end && __f._M_next->first == _M_key) {
+                return &(__f._M_next++)->second;
+            }
+        }
+
+        // The first value of the duplicate key is kept.
+        auto __r = __dict.insert(typename dict_type::value_type(
+            _M_key, value_ptr_type()));
+        return __r.second ? &__r.first->second : nullptr;
+    }
+
+    // Remove the items, which were not decoded in place.
+    void
+    _M_finish(__frame& __f)
+    {
+        if (__f._M_list) {
+            while (__f._M_list->size() > __f._M_index) {
+                __f._M_list->erase(__f._M_list->end() - 1);
+            }
+        } else {
+            while (__f._M_next != __f._M_dict->end()) {
+                __f._M_dict->erase(__f._M_next++);
+            }
+        }
+    }
+
+    // Build the value from the range, which is already validated.
+    value_ptr_type
+    _M_build(const CharT* __p, const CharT* __last, size_type __shape)
+    {
+        // Read the length of the string and move the position past the
+        // delimiter.
+        auto __length = [&__p]() {
+            size_type __n = 0;
+            for (; *__p != basic_value_type::delimiter_token; ++__p) {
+                __n = __n * 10 + size_type(*__p - CharT('0'));
+            }
+            ++__p;
+            return __n;
+        };
+
+        __detail::__skip_handler<CharT, IntT> __skip;
+        value_ptr_type __root;
+
+        _M_stack.clear();
+
+        for (;;) {
+            auto __slot = &__root;
+
+            if (!_M_stack.empty()) {
+                auto& __top = _M_stack.back();
+
+                if (*__p == basic_value_type::end_token) {
+                    ++__p;
+                    _M_finish(__top);
+                    _M_stack.pop_back();
+                    if (_M_stack.empty()) {
+                        return __root;
+                    }
+                    continue;
+                }
+
+                if (__top._M_list) {
+                    if (__top._M_index == __top._M_list->size()) {
+                        __top._M_list->insert(value_ptr_type());
+                    }
+                    __slot = &(*__top._M_list)[__top._M_index++];
+                } else {
+                    auto __n = __length();
+                    _M_key.assign(__p, __n);
+                    __p += __n + 1;
+
+                    __slot = _M_slot(__top);
+                    if (!__slot) {
+                        __p = __detail::__walk_structure<CharT, IntT, Traits>(
+                            __p, __p, __last, __skip,
+                            "bencode::node_pool::parse");
+                        continue;
+                    }
+                }
+
+                // Only the top-level value is matched by the shape.
+                __shape = 0;
+            }
+
+            auto __ch = *__p;
+            if (__ch == basic_value_type::integer_token) {
+                auto __digits = ++__p;
+                while (*__p != basic_value_type::end_token) {
+                    ++__p;
+                }
+
+                IntT __i = 0;
+                decode_integer(__digits, __p++, __i);
+                *_M_acquire<integer_type>(*__slot, __shape) = integer_type(__i);
+            } else if (__ch == basic_value_type::list_token) {
+                auto __list = _M_acquire<list_type>(*__slot, __shape);
+                _M_stack.push_back(__frame{__list, 0, nullptr, {}});
+                ++__p;
+            } else if (__ch == basic_value_type::dict_token) {
+                auto __dict = _M_acquire<dict_type>(*__slot, __shape);
+                _M_stack.push_back(__frame{nullptr, 0, __dict,
+                    __dict->begin()});
+                ++__p;
+            } else {
+                auto __n = __length();
+                _M_acquire<string_type>(*__slot, __shape)->assign(__p, __n);
+                __p += __n;
+            }
+
+            if (_M_stack.empty()) {
+                return __root;
+            }
+        }
+    }
+
+    size_type _M_capacity;
+
+    std::vector<__cached<integer_type>> _M_integers;
+    std::vector<__cached<string_type>> _M_strings;
+    std::vector<__cached<list_type>> _M_lists;
+    std::vector<__cached<dict_type>> _M_dicts;
+
+    // The recycled memory blocks of the same size.
+    std::vector<void*> _M_blocks;
+
+    // The stack of the containers and the key, which are reused between
+    // the calls.
+    std::vector<__frame> _M_stack;
+    string_type _M_key;
+};
+
+
+typedef basic_node_pool<char> node_pool;
+
+
+typedef basic_node_pool<wchar_t> wnode_pool;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_pool_hpp__
@@ -0,0 +1,384 @@
+#ifndef INCLUDE_bencode_push_hpp__
+#define INCLUDE_bencode_push_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <bencode/algorithm.hpp>
+#include <bencode/index.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Status of the push parser.
+ */
+enum class push_status : unsigned char
+{
+    need_more,
+    complete,
+    error
+};
+
+
+/**
+ *  @brief Template class basic_push_parser.
+ *
+ *  @tparam CharT    Character type.
+ *  @tparam Handler  Event handler type.
+ *  @tparam IntT     Integer type, defaults to `int64_t`.
+ *  @tparam Traits   Traits for character type, defaults to
+ *                   `std::char_traits<CharT>`.
+ *
+ *  A resumable parser, which accepts the encoded value in chunks of an
+ *  arbitrary size and reports its tokens to the handler in the same way
+ *  as `sax_parse`. The parser keeps its state between the chunks, so
+ *  every character is looked at only once. The strings are reported as
+ *  the views into the chunk, when the payload is not split between the
+ *  chunks, otherwise the payload is accumulated into the scratch buffer.
+ */
+template
+< typename CharT
+, typename Handler
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> class basic_push_parser
+{
+private:
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    using scope_stack = __detail::__scope_stack;
+
+    // The state of the parser between the characters.
+    enum state : unsigned char
+    {
+        _S_value, _S_integer, _S_length, _S_payload,
+        _S_delimiter, _S_done, _S_error
+    };
+
+public:
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Construct a parser reporting the tokens to the handler.
+     *  @param __handler  Event handler.
+     */
+    explicit
+    basic_push_parser(Handler& __handler)
+    : _M_handler(__handler)
+    { reset(); }
+
+    /**
+     *  @brief Feed the next chunk of the encoded value.
+     *  @param __s  Start of the chunk.
+     *  @param __n  Count of characters in the chunk.
+     *
+     *  Returns `push_status::complete` when the value is complete, the
+     *  characters of the chunk after the value are not consumed, see
+     *  `consumed()`. The next call of `feed()` starts the new value.
+     *  Returns `push_status::need_more` when the whole chunk is consumed,
+     *  but the value is not complete. Returns `push_status::error` on
+     *  the invalid symbol, the parser stays in the error state until
+     *  it is reset.
+     */
+    push_status
+    feed(const CharT* __s, size_type __n)
+    {
+        _M_consumed = 0;
+
+        if (_M_state == _S_error) {
+            return push_status::error;
+        }
+        if (_M_state == _S_done) {
+            reset();
+        }
+
+        auto __p = __s;
+        auto __last = __s + __n;
+
+        while (__p != __last && _M_state != _S_done) {
+            switch (_M_state)
+            {
+            case _S_value:
+                __p = _M_value(__s, __p);
+                break;
+            case _S_integer:
+                __p = _M_integer(__s, __p, __last);
+                break;
+            case _S_length:
+                __p = _M_length(__s, __p, __last);
+                break;
+            case _S_payload:
+                __p = _M_payload(__p, __last);
+                break;
+            case _S_delimiter:
+                if (*__p != basic_value_type::delimiter_token) {
+                    return _M_error("after the key a `:` delimiter expected",
+                        __s, __p);
+                }
+                ++__p;
+                _M_scopes.back() = scope_stack::dict_value;
+                _M_state = _S_value;
+                break;
+            default:
+                break;
+            }
+
+            if (_M_state == _S_error) {
+                return push_status::error;
+            }
+        }
+
+        _M_consumed = size_type(__p - __s);
+        _M_position += _M_consumed;
+        return _M_state == _S_done ?
+            push_status::complete : push_status::need_more;
+    }
+
+    /**
+     *  @brief Returns the count of characters consumed by the last
+     *         call of `feed()`.
+     */
+    size_type
+    consumed() const
+    { return _M_consumed; }
+
+    /**
+     *  @brief Returns the count of characters of the current value
+     *         consumed so far.
+     */
+    size_type
+    position() const
+    { return _M_position; }
+
+    /**
+     *  @brief Returns the description of the error.
+     */
+    const std::string&
+    error() const
+    { return _M_what; }
+
+    /**
+     *  @brief Reset the parser to start the new value.
+     */
+    void
+    reset()
+    {
+        _M_scopes = scope_stack();
+        _M_state = _S_value;
+        _M_what.clear();
+        _M_scratch.clear();
+        _M_position = 0;
+        _M_consumed = 0;
+        _M_pending = 0;
+        _M_count = 0;
+        _M_key = false;
+    }
+
+private:
+    // Parse the first symbol of the next token.
+    const CharT*
+    _M_value(const CharT* __s, const CharT* __p)
+    {
+        auto __ch = *__p;
+
+        if (!_M_scopes.empty() && _M_scopes.back() == scope_stack::dict_key) {
+            if (__ch == basic_value_type::end_token) {
+                _M_handler.end_dict();
+                _M_scopes.pop();
+                _M_complete();
+                return __p + 1;
+            }
+            // Keys of the dictionary are always strings.
+            _M_key = true;
+            _M_count = 0;
+            _M_state = _S_length;
+            return __p;
+        }
+
+        if (__ch == basic_value_type::integer_token) {
+            _M_count = 0;
+            _M_state = _S_integer;
+        } else if (__ch == basic_value_type::list_token) {
+            _M_handler.begin_list();
+            _M_scopes.push(scope_stack::list);
+        } else if (__ch == basic_value_type::dict_token) {
+            _M_handler.begin_dict();
+            _M_scopes.push(scope_stack::dict_key);
+        } else if (__ch == basic_value_type::end_token &&
+                !_M_scopes.empty() && _M_scopes.back() == scope_stack::list) {
+            _M_handler.end_list();
+            _M_scopes.pop();
+            _M_complete();
+        } else if (__ch >= CharT('0') && __ch <= CharT('9')) {
+            _M_key = false;
+            _M_count = 0;
+            _M_state = _S_length;
+            return __p;
+        } else {
+            _M_error("unexpected symbol", __s, __p);
+            return __p;
+        }
+        return __p + 1;
+    }
+
+    // Accumulate the digits of the number, returns the pointer to the
+    // first symbol after the digits.
+    const CharT*
+    _M_digits(const CharT* __p, const CharT* __last)
+    {
+        for (; __p != __last && _M_count < _S_length_limit; ++__p) {
+            auto __ch = *__p;
+            if (!(__ch == CharT('-') ||
+                    (__ch >= CharT('0') && __ch <= CharT('9')))) {
+                break;
+            }
+            _M_buffer[_M_count++] = __ch;
+        }
+        return __p;
+    }
+
+    const CharT*
+    _M_integer(const CharT* __s, const CharT* __p, const CharT* __last)
+    {
+        __p = _M_digits(__p, __last);
+        if (__p == __last) {
+            return __p;
+        }
+        if (*__p != basic_value_type::end_token) {
+            _M_error("the end of the integer `e` expected", __s, __p);
+            return __p;
+        }
+
+        IntT __value;
+        if (decode_integer(_M_buffer, _M_buffer + _M_count, __value) !=
+                integer_errc::success) {
+            _M_error("invalid integer", __s, __p);
+            return __p;
+        }
+
+        _M_handler.on_integer(__value);
+        _M_complete();
+        return __p + 1;
+    }
+
+    const CharT*
+    _M_length(const CharT* __s, const CharT* __p, const CharT* __last)
+    {
+        __p = _M_digits(__p, __last);
+        if (__p == __last) {
+            return __p;
+        }
+        if (*__p != basic_value_type::delimiter_token) {
+            _M_error("the delimiter `:` expected", __s, __p);
+            return __p;
+        }
+
+        int64_t __length;
+        if (decode_integer(_M_buffer, _M_buffer + _M_count, __length) !=
+                integer_errc::success || __length < 0) {
+            _M_error("invalid string length", __s, __p);
+            return __p;
+        }
+
+        _M_pending = size_type(__length);
+        _M_scratch.clear();
+        _M_state = _S_payload;
+        return _M_payload(__p + 1, __last);
+    }
+
+    const CharT*
+    _M_payload(const CharT* __p, const CharT* __last)
+    {
+        auto __avail = size_type(__last - __p);
+
+        if (_M_scratch.empty() && __avail >= _M_pending) {
+            // The whole payload is in the chunk, so it is reported
+            // without copying.
+            _M_string(__p, _M_pending);
+            return __p + _M_pending;
+        }
+
+        auto __count = __avail < _M_pending ? __avail : _M_pending;
+        _M_scratch.append(__p, __count);
+        _M_pending -= __count;
+
+        if (!_M_pending) {
+            _M_string(_M_scratch.data(), _M_scratch.size());
+        }
+        return __p + __count;
+    }
+
+    // Report the complete string or key.
+    void
+    _M_string(const CharT* __s, size_type __n)
+    {
+        if (_M_key) {
+            _M_handler.key(__s, __n);
+            _M_state = _S_delimiter;
+        } else {
+            _M_handler.on_string(__s, __n);
+            _M_complete();
+        }
+    }
+
+    // Complete the value, the next key or the end of the dictionary is
+    // expected, when the value belongs to the dictionary.
+    void
+    _M_complete()
+    {
+        if (_M_scopes.empty()) {
+            _M_state = _S_done;
+            return;
+        }
+        if (_M_scopes.back() == scope_stack::dict_value) {
+            _M_scopes.back() = scope_stack::dict_key;
+        }
+        _M_state = _S_value;
+    }
+
+    push_status
+    _M_error(const char* __what, const CharT* __s, const CharT* __p)
+    {
+        std::ostringstream __error;
+
+        __error << "bencode::push_parser " << __what << " at offset "
+            << (_M_position + size_type(__p - __s)) << "\n";
+
+        _M_what = __error.str();
+        _M_state = _S_error;
+        return push_status::error;
+    }
+
+    static const size_type _S_length_limit =
+        basic_value_type::integer_length;
+
+    Handler& _M_handler;
+    scope_stack _M_scopes;
+    state _M_state;
+
+    std::string _M_what;
+    std::basic_string<CharT, Traits> _M_scratch;
+
+    size_type _M_position;
+    size_type _M_consumed;
+
+    // The count of the unread symbols of the string payload.
+    size_type _M_pending;
+
+    // The digits of the integer or the string length.
+    CharT _M_buffer[_S_length_limit];
+    size_type _M_count;
+
+    // The string being read is the dictionary key.
+    bool _M_key;
+};
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_push_hpp__
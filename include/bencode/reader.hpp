@@ -0,0 +1,377 @@
+#ifndef INCLUDE_bencode_reader_hpp__
+#define INCLUDE_bencode_reader_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <bencode/cursor.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+#include <bencode/skip.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Type of the token of the reader.
+ */
+enum class reader_token : unsigned char
+{
+    none,
+    integer,
+    string,
+    key,
+    begin_list,
+    end_list,
+    begin_dict,
+    end_dict,
+    end
+};
+
+
+/**
+ *  @brief Template class basic_reader.
+ *
+ *  @tparam CharT   Character type, defaults to `char`.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *  @tparam Cursor  Input cursor type, defaults to the buffer cursor.
+ *
+ *  A pull reader of the bencoded values. Each call of `next()` advances
+ *  the reader to the next token. The payloads of the strings and keys
+ *  are not read until they are requested, the unread payloads are
+ *  skipped on the next call of `next()`. Nothing is allocated except
+ *  the string copies requested by the caller and the levels of nesting
+ *  deeper than 64.
+ */
+template
+< typename CharT = char
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+, typename Cursor = basic_buffer_cursor<CharT, Traits>
+> class basic_reader
+{
+private:
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    using scope_stack = __detail::__scope_stack;
+
+public:
+    using cursor_type = Cursor;
+
+    using integer_type = IntT;
+
+    using string_type = std::basic_string<CharT, Traits>;
+
+    using size_type = std::size_t;
+
+    /**
+     *  @brief Construct a reader over the range of characters.
+     *  @param __s  Start of the range.
+     *  @param __n  Count of characters in the range.
+     */
+    basic_reader(const CharT* __s, size_type __n)
+    : _M_cursor(__s, __n), _M_token(reader_token::none),
+      _M_integer(0), _M_length(0), _M_pending(0), _M_delimiter(false)
+    { }
+
+    /**
+     *  @brief Construct a reader over the input stream.
+     *  @param __s  Source input stream.
+     */
+    explicit
+    basic_reader(std::basic_istream<CharT, Traits>& __s)
+    : _M_cursor(__s), _M_token(reader_token::none),
+      _M_integer(0), _M_length(0), _M_pending(0), _M_delimiter(false)
+    { }
+
+    /**
+     *  @brief Advance the reader to the next token.
+     *
+     *  The values of the top level are read one after another, so the
+     *  concatenated values could be read as well. Returns
+     *  `reader_token::end` when the input is over between the values.
+     *  Throws `encoding_error` on the first invalid symbol.
+     */
+    reader_token
+    next()
+    {
+        _M_finish();
+
+        auto __ch = _M_cursor.peek();
+        if (Traits::eq_int_type(__ch, Traits::eof())) {
+            if (!_M_scopes.empty()) {
+                _M_throw("unexpected end of the value");
+            }
+            return _M_token = reader_token::end;
+        }
+
+        if (!_M_scopes.empty() && _M_scopes.back() == scope_stack::dict_key) {
+            if (__ch == basic_value_type::end_token) {
+                _M_cursor.get();
+                _M_scopes.pop();
+                _M_token = reader_token::end_dict;
+            } else {
+                // Keys of the dictionary are always strings, which are
+                // followed by the delimiter token.
+                _M_length = _M_pending = __detail::__extract_length<
+                    CharT, Traits>(_M_cursor, _S_where, 0);
+                _M_delimiter = true;
+                _M_scopes.back() = scope_stack::dict_value;
+                return _M_token = reader_token::key;
+            }
+        } else if (__ch == basic_value_type::integer_token) {
+            _M_integer = __detail::__extract_integer<CharT, IntT, Traits>(
+                _M_cursor, _S_where, 0);
+            _M_token = reader_token::integer;
+        } else if (__ch == basic_value_type::list_token) {
+            _M_cursor.get();
+            _M_scopes.push(scope_stack::list);
+            return _M_token = reader_token::begin_list;
+        } else if (__ch == basic_value_type::dict_token) {
+            _M_cursor.get();
+            _M_scopes.push(scope_stack::dict_key);
+            return _M_token = reader_token::begin_dict;
+        } else if (__ch == basic_value_type::end_token &&
+                !_M_scopes.empty() && _M_scopes.back() == scope_stack::list) {
+            _M_cursor.get();
+            _M_scopes.pop();
+            _M_token = reader_token::end_list;
+        } else if (__ch >= CharT('0') && __ch <= CharT('9')) {
+            _M_length = _M_pending = __detail::__extract_length<
+                CharT, Traits>(_M_cursor, _S_where, 0);
+            _M_token = reader_token::string;
+        } else {
+            _M_throw("unexpected symbol");
+        }
+
+        // The value of the dictionary item is complete, so the next
+        // key or the end of the dictionary is expected.
+        if (!_M_scopes.empty() && _M_scopes.back() == scope_stack::dict_value) {
+            _M_scopes.back() = scope_stack::dict_key;
+        }
+        return _M_token;
+    }
+
+    /**
+     *  @brief Skip the current token.
+     *
+     *  When the current token opens a container, the reader is advanced
+     *  to the token closing it. When the current token is a string or a
+     *  key, its payload is skipped.
+     */
+    void
+    skip()
+    {
+        if (_M_token == reader_token::begin_list ||
+                _M_token == reader_token::begin_dict) {
+            auto __depth = _M_scopes.size();
+            while (next() != reader_token::end && _M_scopes.size() >= __depth)
+            { }
+        } else {
+            _M_finish_payload();
+        }
+    }
+
+    /**
+     *  @brief Returns the type of the current token.
+     */
+    reader_token
+    type() const
+    { return _M_token; }
+
+    /**
+     *  @brief Returns the count of the opened containers.
+     */
+    size_type
+    depth() const
+    { return _M_scopes.size(); }
+
+    /**
+     *  @brief Returns the count of characters read so far.
+     */
+    size_type
+    position() const
+    { return _M_cursor.position(); }
+
+    /**
+     *  @brief Returns the value of the integer token.
+     *
+     *  Throws `type_error` when the current token is not an integer.
+     */
+    integer_type
+    integer() const
+    {
+        if (_M_token != reader_token::integer) {
+            __bencode_throw(type_error("bencode::reader the token is not "
+                "an integer\n"));
+        }
+        return _M_integer;
+    }
+
+    /**
+     *  @brief Returns the length of the string or key token.
+     *
+     *  Throws `type_error` when the current token is not a string.
+     */
+    size_type
+    length() const
+    {
+        _M_check_string();
+        return _M_length;
+    }
+
+    /**
+     *  @brief Read the payload of the string or key token.
+     *  @param __s  Destination array of characters.
+     *  @param __n  Count of characters to read.
+     *
+     *  The payload could be read in several parts. Returns the count of
+     *  read characters, which is zero when the payload is over.
+     */
+    size_type
+    read(CharT* __s, size_type __n)
+    {
+        _M_check_string();
+
+        if (__n > _M_pending) {
+            __n = _M_pending;
+        }
+        if (_M_cursor.read(__s, __n) != __n) {
+            _M_throw("unexpected end of the string");
+        }
+
+        _M_pending -= __n;
+        return __n;
+    }
+
+    /**
+     *  @brief Returns the copy of the payload of the string or key token.
+     *
+     *  The payload should not be read partially before.
+     */
+    string_type
+    string()
+    {
+        _M_check_string();
+
+        string_type __str;
+        if (!__detail::__read_payload(_M_cursor, __str, _M_pending)) {
+            _M_throw("unexpected end of the string");
+        }
+
+        _M_pending = 0;
+        return __str;
+    }
+
+    /**
+     *  @brief Returns the view of the payload of the string or key token.
+     *
+     *  The view is available only for the readers over the contiguous
+     *  buffers, the payload is consumed. The count of characters in the
+     *  view is returned by `length()`.
+     */
+    const CharT*
+    data()
+    {
+        _M_check_string();
+
+        if (!_M_cursor.available(_M_pending)) {
+            _M_throw("unexpected end of the string");
+        }
+
+        auto __data = _M_cursor.current();
+        _M_cursor.ignore(_M_pending);
+        _M_pending = 0;
+        return __data;
+    }
+
+private:
+    // Skip the unread part of the payload.
+    void
+    _M_finish_payload()
+    {
+        if (_M_pending) {
+            if (_M_cursor.ignore(_M_pending) != _M_pending) {
+                _M_throw("unexpected end of the string");
+            }
+            _M_pending = 0;
+        }
+    }
+
+    // Complete the current token before reading the next one.
+    void
+    _M_finish()
+    {
+        _M_finish_payload();
+
+        if (_M_delimiter) {
+            _M_delimiter = false;
+            if (_M_cursor.get() != basic_value_type::delimiter_token) {
+                _M_throw("after the key a `:` delimiter expected");
+            }
+        }
+    }
+
+    void
+    _M_check_string() const
+    {
+        if (_M_token != reader_token::string &&
+                _M_token != reader_token::key) {
+            __bencode_throw(type_error(
+                "bencode::reader the token is not a string\n"));
+        }
+    }
+
+    [[noreturn]] void
+    _M_throw(const char* __what) const
+    { __detail::__throw_cursor_error(_S_where, __what, position()); }
+
+    static constexpr const char* _S_where = "bencode::reader";
+
+    cursor_type _M_cursor;
+    scope_stack _M_scopes;
+
+    reader_token _M_token;
+    integer_type _M_integer;
+
+    // The length of the current string and the count of its unread
+    // symbols.
+    size_type _M_length;
+    size_type _M_pending;
+
+    // The delimiter after the current key is not read yet.
+    bool _M_delimiter;
+};
+
+
+template
+< typename CharT
+, typename IntT
+, typename Traits
+, typename Cursor
+> constexpr const char* basic_reader<CharT, IntT, Traits, Cursor>::_S_where;
+
+
+typedef basic_reader<char> reader;
+
+
+typedef basic_reader<wchar_t> wreader;
+
+
+typedef basic_reader<char, int64_t, std::char_traits<char>,
+    streambuf_cursor> stream_reader;
+
+
+typedef basic_reader<wchar_t, int64_t, std::char_traits<wchar_t>,
+    wstreambuf_cursor> wstream_reader;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_reader_hpp__
@@ -0,0 +1,327 @@
+#ifndef INCLUDE_bencode_sax_hpp__
+#define INCLUDE_bencode_sax_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <bencode/cursor.hpp>
+#include <bencode/dict.hpp>
+#include <bencode/index.hpp>
+#include <bencode/integer.hpp>
+#include <bencode/list.hpp>
+#include <bencode/skip.hpp>
+#include <bencode/string.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+namespace __detail
+{
+
+
+// Adapter of the event handler to the structure walk over the buffer.
+// The strings are reported as the views into the buffer.
+template <typename CharT, typename IntT, typename Handler>
+struct __sax_buffer_handler
+{
+    Handler& _M_handler;
+
+    void
+    integer(const CharT*, IntT __value)
+    { _M_handler.on_integer(__value); }
+
+    void
+    string(const CharT*, const CharT* __s, std::size_t __n)
+    { _M_handler.on_string(__s, __n); }
+
+    void
+    key(const CharT*, const CharT* __s, std::size_t __n)
+    { _M_handler.key(__s, __n); }
+
+    void
+    begin_list(const CharT*)
+    { _M_handler.begin_list(); }
+
+    void
+    end_list(const CharT*)
+    { _M_handler.end_list(); }
+
+    void
+    begin_dict(const CharT*)
+    { _M_handler.begin_dict(); }
+
+    void
+    end_dict(const CharT*)
+    { _M_handler.end_dict(); }
+};
+
+
+// Adapter of the event handler to the cursor walk. The strings are read
+// into the scratch buffer, which is reused across the strings, so only
+// the longest string of the value causes the memory allocation.
+template
+< typename CharT, typename IntT, typename Traits
+, typename Cursor, typename Handler
+> struct __sax_cursor_handler
+{
+    Handler& _M_handler;
+    std::basic_string<CharT, Traits> _M_scratch;
+
+    bool
+    read(Cursor& __c, std::size_t __n)
+    { return __read_payload(__c, _M_scratch, __n); }
+
+    void
+    integer(IntT __value)
+    { _M_handler.on_integer(__value); }
+
+    bool
+    string(Cursor& __c, std::size_t __n)
+    {
+        if (!read(__c, __n)) {
+            return false;
+        }
+        _M_handler.on_string(_M_scratch.data(), __n);
+        return true;
+    }
+
+    bool
+    key(Cursor& __c, std::size_t __n)
+    {
+        if (!read(__c, __n)) {
+            return false;
+        }
+        _M_handler.key(_M_scratch.data(), __n);
+        return true;
+    }
+
+    void
+    begin_list()
+    { _M_handler.begin_list(); }
+
+    void
+    end_list()
+    { _M_handler.end_list(); }
+
+    void
+    begin_dict()
+    { _M_handler.begin_dict(); }
+
+    void
+    end_dict()
+    { _M_handler.end_dict(); }
+};
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Decode the bencoded value into the events.
+ *
+ *  @tparam CharT    Character type.
+ *  @tparam IntT     Integer type, defaults to `int64_t`.
+ *  @tparam Traits   Traits for character type, defaults to
+ *                   `std::char_traits<CharT>`.
+ *  @tparam Handler  Event handler type.
+ *
+ *  @param __s        Start of the range.
+ *  @param __n        Count of characters in the range.
+ *  @param __handler  Event handler.
+ *
+ *  Walks over the first value in the range and calls the methods of the
+ *  @a __handler for each token of the value:
+ *
+ *    on_integer(IntT)
+ *    on_string(const CharT*, std::size_t)
+ *    begin_list(), end_list()
+ *    begin_dict(), key(const CharT*, std::size_t), end_dict()
+ *
+ *  The strings are passed as views into the range, so no memory is
+ *  allocated. Throws `encoding_error` on the first invalid symbol, the
+ *  events reported before it are not revoked. Returns the count of
+ *  consumed characters.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+, typename Handler
+> std::size_t
+sax_parse(const CharT* __s, std::size_t __n, Handler& __handler)
+{
+    __detail::__sax_buffer_handler<CharT, IntT, Handler> __adapter{
+        __handler};
+    auto __end = __detail::__walk_structure<CharT, IntT, Traits>(
+        __s, __s + __n, __adapter, "bencode::sax_parse");
+    return std::size_t(__end - __s);
+}
+
+
+/**
+ *  @brief Decode the bencoded value into the events.
+ *
+ *  @tparam CharT    Character type.
+ *  @tparam IntT     Integer type, defaults to `int64_t`.
+ *  @tparam Traits   Traits for character type, defaults to
+ *                   `std::char_traits<CharT>`.
+ *  @tparam Handler  Event handler type.
+ *
+ *  @param __s        Input stream.
+ *  @param __handler  Event handler.
+ *
+ *  Extracts the first value from the input stream and reports its tokens
+ *  to the @a __handler in the same way as for the character buffers. The
+ *  strings are passed as views into the scratch buffer, which is valid
+ *  only until the handler returns. Returns the count of extracted
+ *  characters.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+, typename Handler
+> std::size_t
+sax_parse(std::basic_istream<CharT, Traits>& __s, Handler& __handler)
+{
+    using cursor_type = basic_streambuf_cursor<CharT, Traits>;
+
+    cursor_type __c(__s);
+    __detail::__sax_cursor_handler<CharT, IntT, Traits, cursor_type,
+        Handler> __adapter{__handler, {}};
+    return __detail::__walk_cursor<CharT, IntT, Traits>(
+        __c, __adapter, "bencode::sax_parse");
+}
+
+
+/**
+ *  @brief Template class basic_value_builder.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *
+ *  Define the event handler, which builds the tree of the bencode
+ *  values from the events of the decoder.
+ */
+template<__bencode_dict_template>
+class basic_value_builder
+{
+private:
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    using value_ptr_type = std::shared_ptr<basic_value_type>;
+
+    using integer_type = basic_integer<__bencode_integer_typenames>;
+
+    using string_type = basic_string<__bencode_string_typenames>;
+
+    using list_type = basic_list<__bencode_list_typenames>;
+
+    using dict_type = basic_dict<__bencode_dict_typenames>;
+
+    // Opened container, which receives the built values.
+    struct __scope
+    {
+        std::shared_ptr<list_type> _M_list;
+        std::shared_ptr<dict_type> _M_dict;
+        typename string_type::string_type _M_key;
+    };
+
+public:
+    /**
+     *  @brief Returns the built value.
+     *
+     *  The value is equal to `nullptr` until the first event.
+     */
+    const value_ptr_type&
+    value() const
+    { return _M_value; }
+
+    void
+    on_integer(IntT __value)
+    {
+        _M_append(__detail::__allocate_value<integer_type, Allocator>(
+            __value));
+    }
+
+    void
+    on_string(const CharT* __s, std::size_t __n)
+    {
+        _M_append(__detail::__allocate_value<string_type, Allocator>(
+            __s, __n));
+    }
+
+    void
+    begin_list()
+    {
+        auto __list = __detail::__allocate_value<list_type, Allocator>();
+        _M_append(__list);
+        _M_scopes.push_back(__scope{__list, nullptr, {}});
+    }
+
+    void
+    end_list()
+    { _M_scopes.pop_back(); }
+
+    void
+    begin_dict()
+    {
+        auto __dict = __detail::__allocate_value<dict_type, Allocator>();
+        _M_append(__dict);
+        _M_scopes.push_back(__scope{nullptr, __dict, {}});
+    }
+
+    void
+    key(const CharT* __s, std::size_t __n)
+    { _M_scopes.back()._M_key.assign(__s, __n); }
+
+    void
+    end_dict()
+    { _M_scopes.pop_back(); }
+
+private:
+    // Append the value to the opened container, the value without the
+    // container is the root one.
+    void
+    _M_append(const value_ptr_type& __value)
+    {
+        if (_M_scopes.empty()) {
+            _M_value = __value;
+            return;
+        }
+
+        auto& __scope = _M_scopes.back();
+        if (__scope._M_list) {
+            __scope._M_list->insert(__value);
+        } else {
+            __scope._M_dict->insert(typename dict_type::value_type(
+                string_type(__scope._M_key), __value));
+        }
+    }
+
+    // The root of the built tree.
+    value_ptr_type _M_value;
+
+    // The stack of the opened containers.
+    std::vector<__scope> _M_scopes;
+};
+
+
+typedef basic_value_builder<char> value_builder;
+
+
+typedef basic_value_builder<wchar_t> wvalue_builder;
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_sax_hpp__
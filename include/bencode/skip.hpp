@@ -0,0 +1,305 @@
+#ifndef INCLUDE_bencode_skip_hpp__
+#define INCLUDE_bencode_skip_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <string>
+#include <bencode/algorithm.hpp>
+#include <bencode/cursor.hpp>
+#include <bencode/exception.hpp>
+#include <bencode/index.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+namespace __detail
+{
+
+
+// Handler of the structure walk, which ignores all tokens. It is used
+// to find the end of the value.
+template <typename CharT, typename IntT>
+struct __skip_handler
+{
+    void integer(const CharT*, IntT) { }
+    void string(const CharT*, const CharT*, std::size_t) { }
+    void key(const CharT*, const CharT*, std::size_t) { }
+    void begin_list(const CharT*) { }
+    void end_list(const CharT*) { }
+    void begin_dict(const CharT*) { }
+    void end_dict(const CharT*) { }
+};
+
+
+// Throw the encoding error pointing to the specified offset from the
+// start of the walked value.
+[[noreturn]] inline void
+__throw_cursor_error(const char* __where, const char* __what,
+    std::size_t __offset)
+{
+    std::ostringstream __error;
+
+    __error << __where << " " << __what << " at offset "
+        << __offset << "\n";
+    __bencode_throw(encoding_error(__error.str()));
+}
+
+
+// Extract the length of the string token available from the cursor
+// together with the following delimiter.
+template <typename CharT, typename Traits, typename Cursor>
+std::size_t
+__extract_length(Cursor& __c, const char* __where, std::size_t __first)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    CharT __digits[basic_value_type::integer_length];
+    auto __count = extract_integer(__c, __digits,
+        basic_value_type::integer_length);
+
+    if (__c.get() != basic_value_type::delimiter_token) {
+        __throw_cursor_error(__where, "the delimiter `:` expected",
+            __c.position() - __first);
+    }
+
+    int64_t __length = 0;
+    if (decode_integer(__digits, __digits + __count, __length) !=
+            integer_errc::success || __length < 0) {
+        __throw_cursor_error(__where, "invalid string length",
+            __c.position() - __first);
+    }
+    return std::size_t(__length);
+}
+
+
+// Extract the integer token available from the cursor.
+template <typename CharT, typename IntT, typename Traits, typename Cursor>
+IntT
+__extract_integer(Cursor& __c, const char* __where, std::size_t __first)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    // Skip the leading "i" symbol.
+    __c.get();
+
+    CharT __digits[basic_value_type::integer_length];
+    auto __count = extract_integer(__c, __digits,
+        basic_value_type::integer_length);
+
+    if (__c.get() != basic_value_type::end_token) {
+        __throw_cursor_error(__where, "the end of the integer `e` expected",
+            __c.position() - __first);
+    }
+
+    IntT __value;
+    if (decode_integer(__digits, __digits + __count, __value) !=
+            integer_errc::success) {
+        __throw_cursor_error(__where, "invalid integer",
+            __c.position() - __first);
+    }
+    return __value;
+}
+
+
+// Walk over the first value available from the cursor and report the
+// tokens to the handler. The structure of the value is validated in the
+// same way as by the structure walk, but the value is read through the
+// cursor interface. The payloads of the strings are consumed by the
+// handler, which returns False when the payload is truncated. Returns
+// the count of extracted symbols.
+template
+< typename CharT, typename IntT, typename Traits
+, typename Cursor, typename Handler
+> std::size_t
+__walk_cursor(Cursor& __c, Handler& __handler, const char* __where)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    __scope_stack __scopes;
+    auto __first = __c.position();
+
+    do {
+        auto __ch = __c.peek();
+        if (Traits::eq_int_type(__ch, Traits::eof())) {
+            __throw_cursor_error(__where, "unexpected end of the value",
+                __c.position() - __first);
+        }
+
+        if (!__scopes.empty() && __scopes.back() == __scope_stack::dict_key) {
+            if (__ch == basic_value_type::end_token) {
+                __c.get();
+                __handler.end_dict();
+                __scopes.pop();
+            } else {
+                // Keys of the dictionary are always strings, which are
+                // followed by the delimiter token.
+                auto __length = __extract_length<CharT, Traits>(
+                    __c, __where, __first);
+                if (!__handler.key(__c, __length)) {
+                    __throw_cursor_error(__where,
+                        "unexpected end of the string",
+                        __c.position() - __first);
+                }
+
+                if (__c.get() != basic_value_type::delimiter_token) {
+                    __throw_cursor_error(__where,
+                        "after the key a `:` delimiter expected",
+                        __c.position() - __first);
+                }
+
+                __scopes.back() = __scope_stack::dict_value;
+                continue;
+            }
+        } else if (__ch == basic_value_type::integer_token) {
+            __handler.integer(__extract_integer<CharT, IntT, Traits>(
+                __c, __where, __first));
+        } else if (__ch == basic_value_type::list_token) {
+            __c.get();
+            __handler.begin_list();
+            __scopes.push(__scope_stack::list);
+            continue;
+        } else if (__ch == basic_value_type::dict_token) {
+            __c.get();
+            __handler.begin_dict();
+            __scopes.push(__scope_stack::dict_key);
+            continue;
+        } else if (__ch == basic_value_type::end_token &&
+                !__scopes.empty() && __scopes.back() == __scope_stack::list) {
+            __c.get();
+            __handler.end_list();
+            __scopes.pop();
+        } else if (__ch >= CharT('0') && __ch <= CharT('9')) {
+            auto __length = __extract_length<CharT, Traits>(
+                __c, __where, __first);
+            if (!__handler.string(__c, __length)) {
+                __throw_cursor_error(__where, "unexpected end of the string",
+                    __c.position() - __first);
+            }
+        } else {
+            __throw_cursor_error(__where, "unexpected symbol",
+                __c.position() - __first);
+        }
+
+        // The value of the dictionary item is complete, so the next
+        // key or the end of the dictionary is expected.
+        if (!__scopes.empty() &&
+                __scopes.back() == __scope_stack::dict_value) {
+            __scopes.back() = __scope_stack::dict_key;
+        }
+    } while (!__scopes.empty());
+
+    return __c.position() - __first;
+}
+
+
+// Handler of the cursor walk, which ignores all tokens and the payloads
+// of the strings.
+template <typename IntT, typename Cursor>
+struct __skip_cursor_handler
+{
+    bool
+    string(Cursor& __c, std::size_t __n)
+    { return __c.ignore(__n) == __n; }
+
+    bool
+    key(Cursor& __c, std::size_t __n)
+    { return __c.ignore(__n) == __n; }
+
+    void integer(IntT) { }
+    void begin_list() { }
+    void end_list() { }
+    void begin_dict() { }
+    void end_dict() { }
+};
+
+
+// Skip the first value of the range, the errors are prefixed with the
+// specified name. Returns the count of skipped symbols.
+template <typename CharT, typename IntT, typename Traits>
+std::size_t
+__skip_value(const CharT* __s, std::size_t __n, const char* __where)
+{
+    __skip_handler<CharT, IntT> __handler;
+    auto __end = __walk_structure<CharT, IntT, Traits>(
+        __s, __s + __n, __handler, __where);
+    return std::size_t(__end - __s);
+}
+
+
+// Skip the first value available from the cursor. Returns the count of
+// skipped symbols.
+template <typename CharT, typename IntT, typename Traits, typename Cursor>
+std::size_t
+__skip_value(Cursor& __c)
+{
+    __skip_cursor_handler<IntT, Cursor> __handler;
+    return __walk_cursor<CharT, IntT, Traits>(
+        __c, __handler, "bencode::skip_value");
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Skip the bencoded value.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s  Start of the range.
+ *  @param __n  Count of characters in the range.
+ *
+ *  Jumps over the first value in the range without decoding it, the
+ *  payloads of the strings are jumped over using their lengths. The
+ *  structure of the value is validated and `encoding_error` is thrown
+ *  on the first invalid symbol. Returns the count of characters of the
+ *  value, so the value spans `[__s, __s + count)`.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::size_t
+skip_value(const CharT* __s, std::size_t __n)
+{
+    return __detail::__skip_value<CharT, IntT, Traits>(
+        __s, __n, "bencode::skip_value");
+}
+
+
+/**
+ *  @brief Skip the bencoded value.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s  Input stream.
+ *
+ *  Extracts the first value from the input stream without decoding it,
+ *  the payloads of the strings are ignored or seeked over when the
+ *  stream buffer supports it. Throws `encoding_error` on the first
+ *  invalid symbol. Returns the count of extracted characters.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> std::size_t
+skip_value(std::basic_istream<CharT, Traits>& __s)
+{
+    basic_streambuf_cursor<CharT, Traits> __c(__s);
+    return __detail::__skip_value<CharT, IntT, Traits>(__c);
+}
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_skip_hpp__
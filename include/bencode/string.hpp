@@ -1,13 +1,261 @@
 #ifndef INCLUDE_bencode_string_hpp__
 #define INCLUDE_bencode_string_hpp__
 
+#include <algorithm>
+#include <cstddef>
+#include <functional>
 #include <iterator>
+#include <memory>
 #include <sstream>
+#include <string>
+#include <utility>
+#include <bencode/algorithm.hpp>
+#include <bencode/cursor.hpp>
 #include <bencode/value.hpp>
 
 
 namespace bencode
 {
+namespace __detail
+{
+
+
+// Storage of the string characters, which keeps the short strings inline
+// and allocates the memory only for the longer ones. The inline buffer
+// takes 24 bytes, so the whole storage is not larger than the standard
+// string. For `char` it fits the most of the dictionary keys and the
+// 20-byte hashes.
+template
+< typename CharT
+, typename Traits
+, typename Alloc
+> class __short_string
+{
+private:
+    using alloc_traits = std::allocator_traits<Alloc>;
+
+public:
+    using size_type = std::size_t;
+
+    // The count of characters kept inline.
+    static const size_type local_capacity = 24 / sizeof(CharT);
+
+    explicit
+    __short_string(const Alloc& __a = Alloc()) noexcept
+    : _M_impl(__a)
+    { }
+
+    __short_string(const CharT* __s, size_type __n,
+        const Alloc& __a = Alloc())
+    : _M_impl(__a)
+    { assign(__s, __n); }
+
+    __short_string(const __short_string& __str)
+    : _M_impl(alloc_traits::select_on_container_copy_construction(
+        __str._M_impl))
+    { assign(__str.data(), __str.size()); }
+
+    __short_string(__short_string&& __str) noexcept
+    : _M_impl(std::move(static_cast<Alloc&>(__str._M_impl)))
+    { _M_steal(__str); }
+
+    ~__short_string()
+    { _M_release(); }
+
+    __short_string&
+    operator=(const __short_string& __str)
+    {
+        if (this != &__str) {
+            assign(__str.data(), __str.size());
+        }
+        return *this;
+    }
+
+    __short_string&
+    operator=(__short_string&& __str)
+    {
+        if (this == &__str) {
+            return *this;
+        }
+
+        // The memory of the different allocator could not be taken.
+        if (!__str._M_local() && static_cast<Alloc&>(_M_impl) !=
+                static_cast<Alloc&>(__str._M_impl)) {
+            assign(__str.data(), __str.size());
+        } else {
+            _M_release();
+            _M_steal(__str);
+        }
+        return *this;
+    }
+
+    size_type
+    size() const noexcept
+    { return _M_impl._M_size; }
+
+    CharT*
+    data() noexcept
+    { return _M_local() ? _M_impl._M_buf : _M_impl._M_heap._M_ptr; }
+
+    const CharT*
+    data() const noexcept
+    { return _M_local() ? _M_impl._M_buf : _M_impl._M_heap._M_ptr; }
+
+    // Make the room for the specified count of characters and return the
+    // pointer to them. The allocated memory is reused, when it is large
+    // enough, and the content is unspecified.
+    CharT*
+    prepare(size_type __n)
+    {
+        if (__n <= local_capacity) {
+            _M_release();
+            _M_impl._M_size = __n;
+            return _M_impl._M_buf;
+        }
+
+        if (!_M_local() && __n <= _M_impl._M_heap._M_capacity) {
+            _M_impl._M_size = __n;
+            return _M_impl._M_heap._M_ptr;
+        }
+
+        auto __ptr = alloc_traits::allocate(_M_impl, __n);
+        _M_release();
+        _M_impl._M_heap._M_ptr = __ptr;
+        _M_impl._M_heap._M_capacity = __n;
+        _M_impl._M_size = __n;
+        return __ptr;
+    }
+
+    // Change the count of characters, the leading characters are kept.
+    // The allocated memory at least doubles, when it grows, so the
+    // string could be extended by the small steps.
+    CharT*
+    resize(size_type __n)
+    {
+        if (__n <= local_capacity) {
+            if (!_M_local()) {
+                auto __heap = _M_impl._M_heap;
+                Traits::copy(_M_impl._M_buf, __heap._M_ptr, __n);
+                alloc_traits::deallocate(_M_impl, __heap._M_ptr,
+                    __heap._M_capacity);
+            }
+            _M_impl._M_size = __n;
+            return _M_impl._M_buf;
+        }
+
+        auto __capacity = _M_local() ? local_capacity :
+            _M_impl._M_heap._M_capacity;
+
+        if (__n <= __capacity) {
+            _M_impl._M_size = __n;
+            return _M_impl._M_heap._M_ptr;
+        }
+
+        auto __ptr = alloc_traits::allocate(_M_impl,
+            std::max(__n, 2 * __capacity));
+        Traits::copy(__ptr, data(), size());
+        _M_release();
+        _M_impl._M_heap._M_ptr = __ptr;
+        _M_impl._M_heap._M_capacity = std::max(__n, 2 * __capacity);
+        _M_impl._M_size = __n;
+        return __ptr;
+    }
+
+    void
+    assign(const CharT* __s, size_type __n)
+    {
+        if (!__n) {
+            _M_release();
+            return;
+        }
+
+        // The characters of the string itself are moved to its start,
+        // before the allocated memory could be released.
+        if (_M_contains(__s)) {
+            Traits::move(data(), __s, __n);
+            resize(__n);
+            return;
+        }
+        Traits::copy(prepare(__n), __s, __n);
+    }
+
+    int
+    compare(const CharT* __s, size_type __n) const noexcept
+    {
+        auto __c = Traits::compare(data(), __s, std::min(size(), __n));
+        if (__c) {
+            return __c;
+        }
+        return size() < __n ? -1 : (size() > __n ? 1 : 0);
+    }
+
+private:
+    bool
+    _M_local() const noexcept
+    { return _M_impl._M_size <= local_capacity; }
+
+    bool
+    _M_contains(const CharT* __s) const noexcept
+    {
+        std::less<const CharT*> __less;
+        return !__less(__s, data()) && __less(__s, data() + size());
+    }
+
+    void
+    _M_release() noexcept
+    {
+        if (!_M_local()) {
+            alloc_traits::deallocate(_M_impl, _M_impl._M_heap._M_ptr,
+                _M_impl._M_heap._M_capacity);
+        }
+        _M_impl._M_size = 0;
+    }
+
+    // Take the characters of the string, which is left empty. The
+    // storage should be released already.
+    void
+    _M_steal(__short_string& __str) noexcept
+    {
+        if (__str._M_local()) {
+            Traits::copy(_M_impl._M_buf, __str._M_impl._M_buf,
+                __str.size());
+        } else {
+            _M_impl._M_heap = __str._M_impl._M_heap;
+        }
+        _M_impl._M_size = __str._M_impl._M_size;
+        __str._M_impl._M_size = 0;
+    }
+
+    struct __heap
+    {
+        CharT* _M_ptr;
+        size_type _M_capacity;
+    };
+
+    // The empty allocator does not take any space.
+    struct __impl : Alloc
+    {
+        __impl(const Alloc& __a) noexcept
+        : Alloc(__a), _M_size(0), _M_heap()
+        { }
+
+        __impl(Alloc&& __a) noexcept
+        : Alloc(std::move(__a)), _M_size(0), _M_heap()
+        { }
+
+        size_type _M_size;
+
+        union {
+            __heap _M_heap;
+            CharT _M_buf[local_capacity];
+        };
+    };
+
+    __impl _M_impl;
+};
+
+
+} // namespace __detail
 
 
 template
@@ -36,15 +284,27 @@ public:
      */
     using size_type = typename string_type::size_type;
 
+    /**
+     *  @brief Count of characters stored without memory allocation.
+     */
+    static const size_type local_capacity = __detail::__short_string<
+        CharT, Traits, allocator_type>::local_capacity;
+
+    /**
+     *  @brief Count of characters extracted at once from the input, which
+     *         end is not known.
+     */
+    static const size_type read_chunk = __detail::__read_chunk;
+
     /**
      *  @brief Mutable symbols iterator.
      */
-    using iterator = typename string_type::iterator;
+    using iterator = CharT*;
 
     /**
      *  @brief Immutable (constant) symbols iterator.
      */
-    using const_iterator = typename string_type::const_iterator;
+    using const_iterator = const CharT*;
 
     /**
      *  @brief Construct an empty string.
@@ -57,10 +317,8 @@ public:
      *  @param __value  Reference to the basic type.
      */
     basic_string(const basic_value_type& __value)
-    {
-        auto __string = dynamic_cast<const basic_string&>(__value);
-        _M_value = __string._M_value;
-    }
+    : _M_value(dynamic_cast<const basic_string&>(__value)._M_value)
+    { }
 
     /**
      *  @brief Construct a string using downcasted pointer to the basic type.
@@ -80,12 +338,21 @@ public:
     : _M_value(__str._M_value)
     { }
 
+    /**
+     *  @brief Construct a string with the characters of @a str, the
+     *         source string is left empty.
+     *  @param __str  Source string.
+     */
+    basic_string(basic_string&& __str) noexcept
+    : _M_value(std::move(__str._M_value))
+    { }
+
     /**
      *  @brief Construct a string as a copy of @a str.
      *  @param __str  Source string.
      */
     basic_string(const string_type& __str)
-    : _M_value(__str)
+    : _M_value(__str.data(), __str.size())
     { }
 
     /**
@@ -93,20 +360,37 @@ public:
      *  @param __chars  Source character array.
      */
     basic_string(const CharT* __chars)
-    : _M_value(__chars)
+    : _M_value(__chars, Traits::length(__chars))
+    { }
+
+    /**
+     *  @brief Construct a string initialized by a character %array.
+     *  @param __chars  Source character array.
+     *  @param __n      Count of characters in the array.
+     */
+    basic_string(const CharT* __chars, size_type __n)
+    : _M_value(__chars, __n)
     { }
 
     ~basic_string()
     { }
 
+    basic_string&
+    operator=(const basic_string& __str) = default;
+
+    basic_string&
+    operator=(basic_string&& __str) = default;
+
     /**
      *  @brief Serialize the string value to the specified output stream.
      *  @param __s  Reference to the output stream.
      */
     void
     dump(std::basic_ostream<CharT, Traits>& __s) const
-    { __s << _M_value.length() << basic_value_type::delimiter_token
-        << _M_value; }
+    {
+        __s << _M_value.size() << basic_value_type::delimiter_token;
+        __s.write(_M_value.data(), _M_value.size());
+    }
 
     /**
      *  @brief Deserialize the string value from the specified input stream.
@@ -115,46 +399,78 @@ public:
     void
     load(std::basic_istream<CharT, Traits>& __s)
     {
-        // Define the integer symbol representation placeholder.
-        std::basic_stringstream<CharT, Traits> __i;
-
-        // Define the input stream iterator of the provided stream to
-        // be able to read the string length value symbol by symbol.
-        auto __si = std::istream_iterator<CharT, CharT, Traits>(__s);
-
-        // Define the output stream to as a buffer for the integer
-        // value, which will be later converted.
-        auto __ival = std::ostream_iterator<CharT, CharT, Traits>(__i);
-
-        // Copy the symbols from the input stream to the integer
-        // placeholder until the ":" delimiter value.
-        auto __result = copy_until(__si, __ival,
-            [&__s](const CharT& __ch) {
-
-            // Additionally, check that we did not exceed the
-            // length of the stream to prevent hangs.
-            return !__s.eof() && __ch != basic_value_type::delimiter_token;
-        }, basic_value_type::integer_length);
+        basic_streambuf_cursor<CharT, Traits> __c(__s);
+        decode(__c);
+    }
 
-        if (*__result != basic_value_type::delimiter_token) {
+    /**
+     *  @brief Deserialize the string value from the specified cursor.
+     *  @param __c  Reference to the input cursor.
+     */
+    template <typename Cursor>
+    void
+    decode(Cursor& __c)
+    {
+        // Define the integer symbol representation placeholder, the
+        // count of symbols is limited to prevent the buffer overload.
+        CharT __digits[basic_value_type::integer_length];
+        auto __ndigits = extract_integer(__c, __digits,
+            std::size_t(basic_value_type::integer_length));
+        auto __ch = __c.peek();
+
+        if (__ch != basic_value_type::delimiter_token) {
             std::ostringstream __error;
 
+            // The symbols limit is reached, but the length is longer.
+            if (__ndigits == std::size_t(basic_value_type::integer_length)) {
+                __error << "bencode::string::load the specified string "
+                    "length is out of range\n";
+                __bencode_throw(value_error(__error.str()));
+            }
+
+            // The length is not started with a digit at all.
+            if (!__ndigits && !Traits::eq_int_type(__ch, Traits::eof())) {
+                __error << "bencode::string::load the specified string "
+                    "length is not a number\n";
+                __bencode_throw(value_error(__error.str()));
+            }
+
+            // When the input is exhausted, report the last extracted
+            // symbol, since there is nothing else to show.
+            if (Traits::eq_int_type(__ch, Traits::eof()) && __ndigits) {
+                __ch = Traits::to_int_type(__digits[__ndigits-1]);
+            }
+
             __error << "bencode::string::load the delimiter `:` "
-                "expected, but `" << CharT(*__result) << "` found\n";
-            throw encoding_error(__error.str());
+                "expected, but `" << CharT(__ch) << "` found\n";
+            __bencode_throw(encoding_error(__error.str()));
         }
 
-        // Save the length of the string.
-        int64_t __count;
-        __i >> __count;
-
-        if (!__count && __i.str() != std::basic_string<
-                CharT, Traits>(1, CharT('0'))) {
-            std::ostringstream __error;
+        // Read the ":" symbol from the provided cursor.
+        __c.get();
 
-            __error << "bencode::string::load the specified string "
-                "length is not a number\n";
-            throw value_error(__error.str());
+        // Save the length of the string.
+        int64_t __count = 0;
+
+        switch (decode_integer(__digits, __digits + __ndigits, __count)) {
+        case integer_errc::success:
+            break;
+        case integer_errc::leading_zero:
+            __bencode_throw(value_error(
+                "bencode::string::load the specified string "
+                "length has redundant leading zeros\n"));
+        case integer_errc::negative_zero:
+            __bencode_throw(value_error(
+                "bencode::string::load the length of the "
+                "string value must be a positive integer: `-0`\n"));
+        case integer_errc::out_of_range:
+            __bencode_throw(value_error(
+                "bencode::string::load the specified string "
+                "length is out of range\n"));
+        default:
+            __bencode_throw(value_error(
+                "bencode::string::load the specified string "
+                "length is not a number\n"));
         }
 
         // Ensure that the string length is a non-negative value.
@@ -163,29 +479,51 @@ public:
 
             __error << "bencode::string::load the length of the string "
                 "value must be a positive integer: `" << __count << "`\n";
-            throw value_error(__error.str());
+            __bencode_throw(value_error(__error.str()));
         }
 
-        // Allocate the list of symbols of the specified string length.
-        std::unique_ptr<CharT[]> __str(new CharT[__count+1]);
+        // Fail before the allocation of the string, when the cursor
+        // is known to be shorter than the declared string length.
+        auto __n = std::size_t(__count);
+        std::size_t __length = 0;
+
+        if (!__c.available(__n)) {
+            __length = __c.ignore(__n);
+        } else if (__c.remaining() >= __n) {
+            // Copy the whole block of symbols right into the storage,
+            // the short strings are kept inline.
+            __length = __c.read(_M_value.prepare(__n), __n);
+        } else {
+            // The end of the input is not known, so the storage grows
+            // with the extracted symbols, not with the declared length.
+            _M_value.assign(nullptr, 0);
+
+            while (__length < __n) {
+                auto __step = std::min(__n - __length,
+                    std::max(__length, std::size_t(read_chunk)));
+                auto __data = _M_value.resize(__length + __step);
+                auto __extracted = __c.read(__data + __length, __step);
+
+                __length += __extracted;
+                if (__extracted != __step) {
+                    break;
+                }
+            }
+        }
 
-        // Read the string value into the symbol list.
-        __s.get(__str.get(), std::streamsize(__count+1));
-        auto __strval = string_type(__str.get());
+        if (__length == __n) {
+            return;
+        }
+        _M_value.assign(nullptr, 0);
 
         // Ensure that valid count of the symbols was extracted from
-        // the provided input stream.
-        if (int64_t(__strval.length()) != __count) {
-            std::ostringstream __error;
-
-            __error << "bencode::string::load the specified string "
-                "decoded length is not equal to the real one: `" << __count
-                << "` != `" << __strval.length() << "`\n";
-            throw value_error(__error.str());
-        }
+        // the provided cursor.
+        std::ostringstream __error;
 
-        // Initialize the internal value with a new string.
-        _M_value = __strval;
+        __error << "bencode::string::load the specified string "
+            "decoded length is not equal to the real one: `" << __count
+            << "` != `" << __length << "`\n";
+        __bencode_throw(value_error(__error.str()));
     }
 
     /**
@@ -196,7 +534,7 @@ public:
      */
     size_type
     size() const
-    { return _M_value.length(); }
+    { return _M_value.size(); }
 
     /**
      *  @brief Iterator to the first character.
@@ -206,7 +544,7 @@ public:
      */
     iterator
     begin()
-    { return _M_value.begin(); }
+    { return _M_value.data(); }
 
     /**
      *  @brief Iterator to the last character.
@@ -216,7 +554,7 @@ public:
      */
     iterator
     end()
-    { return _M_value.end(); }
+    { return _M_value.data() + _M_value.size(); }
 
     /**
      *  @brief Constant iterator to the first character.
@@ -226,7 +564,7 @@ public:
      */
     const_iterator
     cbegin() const
-    { return _M_value.cbegin(); }
+    { return _M_value.data(); }
 
     /**
      *  @brief Constant iterator to the last character.
@@ -236,7 +574,18 @@ public:
      */
     const_iterator
     cend() const
-    { return _M_value.cend(); }
+    { return _M_value.data() + _M_value.size(); }
+
+    /**
+     *  @brief Replace the content of the %string.
+     *  @param __s  Start of the characters.
+     *  @param __n  Count of the characters.
+     *
+     *  The allocated storage is reused, when it is large enough.
+     */
+    void
+    assign(const CharT* __s, size_type __n)
+    { _M_value.assign(__s, __n); }
 
     /**
      *  @brief Convert to the underlying string type.
@@ -245,7 +594,7 @@ public:
      */
     operator
     string_type() const
-    { return _M_value; }
+    { return string_type(_M_value.data(), _M_value.size()); }
 
     /**
      *  @brief Test the equivalence of the strings.
@@ -256,7 +605,7 @@ public:
      */
     bool
     operator==(const basic_string& __s) const noexcept(true)
-    { return _M_value == __s._M_value; }
+    { return _M_value.compare(__s._M_value.data(), __s.size()) == 0; }
 
     /**
      *  @brief Test the equivalence of the strings.
@@ -267,10 +616,10 @@ public:
      */
     bool
     operator==(const string_type& __s)
-    { return _M_value == __s; }
+    { return _M_value.compare(__s.data(), __s.size()) == 0; }
 
 private:
-    string_type _M_value;
+    __detail::__short_string<CharT, Traits, allocator_type> _M_value;
 };
 
 
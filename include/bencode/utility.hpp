@@ -22,11 +22,8 @@ inline namespace literals
  *  is constructed by parsing the provided string.
  */
 std::shared_ptr<basic_value<char>>
-inline operator"" _bencode(const char* __str, std::size_t)
-{
-    std::istringstream __ss(__str);
-    return make_value<char>(__ss);
-}
+inline operator"" _bencode(const char* __str, std::size_t __len)
+{ return parse<char>(__str, __len).first; }
 
 
 /**
@@ -37,11 +34,8 @@ inline operator"" _bencode(const char* __str, std::size_t)
  *  is constructed by parsing the provided string.
  */
 std::shared_ptr<basic_value<wchar_t>>
-inline operator"" _bencode(const wchar_t* __str, std::size_t)
-{
-    std::wistringstream __ss(__str);
-    return make_value<wchar_t>(__ss);
-}
+inline operator"" _bencode(const wchar_t* __str, std::size_t __len)
+{ return parse<wchar_t>(__str, __len).first; }
 
 
 /**
@@ -52,11 +46,8 @@ inline operator"" _bencode(const wchar_t* __str, std::size_t)
  *  is constructed by parsing the provided string.
  */
 std::shared_ptr<basic_value<char16_t>>
-inline operator"" _bencode(const char16_t* __str, std::size_t)
-{
-    std::basic_stringstream<char16_t> __ss(__str);
-    return make_value<char16_t>(__ss);
-}
+inline operator"" _bencode(const char16_t* __str, std::size_t __len)
+{ return parse<char16_t>(__str, __len).first; }
 
 
 /**
@@ -67,11 +58,8 @@ inline operator"" _bencode(const char16_t* __str, std::size_t)
  *  is constructed by parsing the provided string.
  */
 std::shared_ptr<basic_value<char32_t>>
-inline operator"" _bencode(const char32_t* __str, std::size_t)
-{
-    std::basic_stringstream<char32_t> __ss(__str);
-    return make_value<char32_t>(__ss);
-}
+inline operator"" _bencode(const char32_t* __str, std::size_t __len)
+{ return parse<char32_t>(__str, __len).first; }
 
 
 } // inline namespace listerals
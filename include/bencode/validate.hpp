@@ -0,0 +1,334 @@
+#ifndef INCLUDE_bencode_validate_hpp__
+#define INCLUDE_bencode_validate_hpp__
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <bencode/algorithm.hpp>
+#include <bencode/error.hpp>
+#include <bencode/index.hpp>
+#include <bencode/value.hpp>
+
+
+namespace bencode
+{
+
+
+/**
+ *  @brief Result of the validation.
+ */
+struct validate_result
+{
+    // The kind of the first error, or `errc::success`.
+    errc code;
+
+    // The offset of the first error, or the length of the valid value.
+    std::size_t offset;
+
+    /**
+     *  @brief Returns True when the value is well-formed.
+     */
+    explicit
+    operator bool() const noexcept
+    { return code == errc::success; }
+};
+
+
+namespace __detail
+{
+
+
+// The upper bound of the nesting depth checked by the validation, the
+// kinds of the opened containers are stored in the bit set of this size
+// on the stack.
+static const std::size_t __validate_depth_limit = 4096;
+
+
+inline errc
+__integer_error(integer_errc __e) noexcept
+{
+    switch (__e)
+    {
+    case integer_errc::success:
+        return errc::success;
+    case integer_errc::leading_zero:
+        return errc::leading_zero;
+    case integer_errc::negative_zero:
+        return errc::negative_zero;
+    case integer_errc::out_of_range:
+        return errc::integer_overflow;
+    default:
+        return errc::invalid_integer;
+    }
+}
+
+
+// Check the string token at the specified position, on success the
+// position is moved right past its payload.
+template <typename CharT, typename Traits>
+errc
+__validate_string(const CharT*& __p, const CharT* __last,
+    std::size_t& __length) noexcept
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    auto __end = __find_integer_end<CharT, Traits>(__p, __last);
+    if (__end == __last) {
+        __p = __end;
+        return errc::unexpected_end;
+    }
+    if (*__end != basic_value_type::delimiter_token) {
+        __p = __end;
+        return errc::missing_delimiter;
+    }
+
+    uint64_t __count = 0;
+    auto __e = decode_integer(__p, __end, __count);
+    if (__e != integer_errc::success) {
+        return __e == integer_errc::leading_zero ?
+            errc::leading_zero : errc::invalid_length;
+    }
+
+    ++__end;
+    if (__count > uint64_t(__last - __end)) {
+        __p = __last;
+        return errc::unexpected_end;
+    }
+
+    __length = std::size_t(__count);
+    __p = __end + __length;
+    return errc::success;
+}
+
+
+// Check the integer token at the specified position, on success the
+// position is moved right past its end token.
+template <typename CharT, typename IntT, typename Traits>
+errc
+__validate_integer(const CharT*& __p, const CharT* __last) noexcept
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    auto __digits = __p + 1;
+    auto __end = __find_integer_end<CharT, Traits>(__digits, __last);
+    if (__end == __last) {
+        __p = __end;
+        return errc::unexpected_end;
+    }
+    if (*__end != basic_value_type::end_token) {
+        // The symbols limit is reached, but the integer is longer.
+        bool __long = __end - __digits == basic_value_type::integer_length;
+
+        __p = __long ? __digits : __end;
+        return __long ? errc::integer_overflow : errc::invalid_integer;
+    }
+
+    IntT __value;
+    auto __e = __integer_error(decode_integer(__digits, __end, __value));
+    if (__e != errc::success) {
+        __p = __digits;
+        return __e;
+    }
+
+    __p = __end + 1;
+    return errc::success;
+}
+
+
+// Handler of the validation, which accepts the keys in any order.
+struct __validate_handler
+{
+    void
+    begin_dict(std::size_t) noexcept
+    { }
+
+    template <typename CharT>
+    errc
+    key(std::size_t, const CharT*, const CharT*, std::size_t) noexcept
+    { return errc::success; }
+};
+
+
+// Check the first value in the range, the handler is notified about the
+// dictionaries and their keys at the specified nesting level.
+template
+< typename CharT
+, typename IntT
+, typename Traits
+, typename Handler
+> validate_result
+__validate(const CharT* __s, std::size_t __n, std::size_t __depth,
+    Handler& __handler)
+{
+    using basic_value_type = basic_value<CharT, Traits>;
+
+    const auto __limit = __validate_depth_limit;
+    if (__depth > __limit) {
+        __depth = __limit;
+    }
+
+    // The bit is set for each opened dictionary.
+    uint64_t __dicts[__limit / 64];
+    std::size_t __size = 0;
+    bool __value = false;
+
+    auto __p = __s;
+    auto __last = __s + __n;
+    auto __e = errc::success;
+
+    auto __is_dict = [&](std::size_t __i) {
+        return (__dicts[__i / 64] >> (__i % 64)) & 1;
+    };
+
+    do {
+        if (__p == __last) {
+            return validate_result{errc::unexpected_end, __n};
+        }
+
+        auto __ch = *__p;
+        auto __token = __p;
+
+        // The key or the end of the dictionary is expected.
+        if (__size && __is_dict(__size - 1) && !__value) {
+            if (__ch == basic_value_type::end_token) {
+                --__size;
+                ++__p;
+                continue;
+            }
+            if (!(__ch >= CharT('0') && __ch <= CharT('9'))) {
+                return validate_result{errc::invalid_key,
+                    std::size_t(__p - __s)};
+            }
+
+            std::size_t __length = 0;
+            __e = __validate_string<CharT, Traits>(__p, __last, __length);
+            if (__e == errc::success) {
+                __e = __handler.key(__size - 1, __token, __p - __length,
+                    __length);
+                if (__e != errc::success) {
+                    __p = __token;
+                } else if (__p == __last) {
+                    __e = errc::unexpected_end;
+                } else if (*__p != basic_value_type::delimiter_token) {
+                    __e = errc::missing_delimiter;
+                }
+            }
+            if (__e != errc::success) {
+                return validate_result{__e, std::size_t(__p - __s)};
+            }
+
+            ++__p;
+            __value = true;
+            continue;
+        }
+
+        if (__ch == basic_value_type::list_token ||
+                __ch == basic_value_type::dict_token) {
+            if (__size == __depth) {
+                return validate_result{errc::depth_exceeded,
+                    std::size_t(__token - __s)};
+            }
+
+            auto __bit = uint64_t(1) << (__size % 64);
+            if (__ch == basic_value_type::dict_token) {
+                __dicts[__size / 64] |= __bit;
+                __handler.begin_dict(__size);
+            } else {
+                __dicts[__size / 64] &= ~__bit;
+            }
+
+            ++__size;
+            ++__p;
+            __value = false;
+            continue;
+        }
+
+        if (__ch == basic_value_type::integer_token) {
+            __e = __validate_integer<CharT, IntT, Traits>(__p, __last);
+        } else if (__ch >= CharT('0') && __ch <= CharT('9')) {
+            std::size_t __length = 0;
+            __e = __validate_string<CharT, Traits>(__p, __last, __length);
+        } else if (__ch == basic_value_type::end_token &&
+                __size && !__value) {
+            --__size;
+            ++__p;
+        } else {
+            __e = errc::unexpected_token;
+        }
+
+        if (__e != errc::success) {
+            return validate_result{__e, std::size_t(__p - __s)};
+        }
+
+        // The value of the dictionary item is complete.
+        __value = false;
+    } while (__size);
+
+    if (__p != __last) {
+        return validate_result{errc::trailing_data, std::size_t(__p - __s)};
+    }
+    return validate_result{errc::success, __n};
+}
+
+
+} // namespace __detail
+
+
+/**
+ *  @brief Check that the range contains the single well-formed value.
+ *
+ *  @tparam CharT   Character type.
+ *  @tparam IntT    Integer type, defaults to `int64_t`.
+ *  @tparam Traits  Traits for character type, defaults to
+ *                  `std::char_traits<CharT>`.
+ *
+ *  @param __s      Start of the range.
+ *  @param __n      Count of characters in the range.
+ *  @param __depth  Maximum nesting depth, which is limited to 4096.
+ *
+ *  The range is checked in a single pass without any memory allocation
+ *  and without exceptions. The integers should fit into @a IntT and have
+ *  no leading zeros, the string lengths should have no leading zeros and
+ *  fit into the range, the keys of the dictionaries should be strings
+ *  and the range should contain nothing after the value. Returns the
+ *  kind and the offset of the first error.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+> validate_result
+validate(const CharT* __s, std::size_t __n, std::size_t __depth = 512) noexcept
+{
+    __detail::__validate_handler __handler;
+    return __detail::__validate<CharT, IntT, Traits>(
+        __s, __n, __depth, __handler);
+}
+
+
+/**
+ *  @brief Check that the string contains the single well-formed value.
+ *
+ *  @tparam CharT        Character type.
+ *  @tparam IntT         Integer type, defaults to `int64_t`.
+ *  @tparam Traits       Traits for character type, defaults to
+ *                       `std::char_traits<CharT>`.
+ *  @tparam StringAlloc  Allocator type of the string.
+ *
+ *  @param __str    Source string.
+ *  @param __depth  Maximum nesting depth, which is limited to 4096.
+ */
+template
+< typename CharT
+, typename IntT = int64_t
+, typename Traits = std::char_traits<CharT>
+, typename StringAlloc
+> validate_result
+validate(const std::basic_string<CharT, Traits, StringAlloc>& __str,
+    std::size_t __depth = 512) noexcept
+{ return validate<CharT, IntT, Traits>(__str.data(), __str.size(), __depth); }
+
+
+} // namespace bencode
+
+#endif // INCLUDE_bencode_validate_hpp__
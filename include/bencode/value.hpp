@@ -10,6 +10,7 @@
 #include <string>
 #include <utility>
 #include <vector>
+#include <bencode/cursor.hpp>
 #include <bencode/exception.hpp>
 
 
@@ -72,6 +73,28 @@ public:
 };
 
 
+namespace __detail
+{
+
+
+// Allocate the value together with the control block of the shared
+// pointer using the allocator of the value, so the nodes are placed to
+// the same memory as the containers and the strings they keep.
+template
+< typename T
+, template <typename> class Allocator
+, typename... Args
+> std::shared_ptr<T>
+__allocate_value(Args&&... __args)
+{
+    return std::allocate_shared<T>(Allocator<T>(),
+        std::forward<Args>(__args)...);
+}
+
+
+} // namespace __detail
+
+
 // Define integer template typenames used in within class and
 // function definitions.
 #define __bencode_integer_template \
@@ -98,22 +121,29 @@ template<__bencode_integer_template> class basic_integer;
 /**
  *  @brief Create an integer shared pointer.
  *
- *  @tparam CharT   Character type, defaults to `char`.
- *  @tparam IntT    Integer type, defaults to `int64_t`.
- *  @tparam Traits  Traits for character type, defaults to
- *                  `std::char_traits<CharT>`.
+ *  @tparam CharT      Character type, defaults to `char`.
+ *  @tparam IntT       Integer type, defaults to `int64_t`.
+ *  @tparam Traits     Traits for character type, defaults to
+ *                     `std::char_traits<CharT>`.
+ *  @tparam Allocator  Allocator type, defaults to `std::allocator`.
  *
  *  @param __args  Arguments for integer constructor.
  *
  *  Returns a shared pointer to the integer type initialized using
  *  a provided value.
  */
-template<__bencode_integer_template, typename ...Args>
-std::shared_ptr<basic_integer<__bencode_integer_typenames>>
+template
+< __bencode_integer_template
+, template
+  < typename T
+  > class Allocator = std::allocator
+, typename ...Args
+> std::shared_ptr<basic_integer<__bencode_integer_typenames>>
 make_integer(Args&&... __args)
 {
-    return std::make_shared<basic_integer<
-        __bencode_integer_typenames>>(std::forward<Args>(__args)...);
+    return __detail::__allocate_value<basic_integer<
+        __bencode_integer_typenames>, Allocator>(
+        std::forward<Args>(__args)...);
 }
 
 
@@ -157,8 +187,9 @@ template<__bencode_string_template, typename ...Args>
 std::shared_ptr<basic_string<__bencode_string_typenames>>
 make_string(Args&&... __args)
 {
-    return std::make_shared<basic_string<
-        __bencode_string_typenames>>(std::forward<Args>(__args)...);
+    return __detail::__allocate_value<basic_string<
+        __bencode_string_typenames>, Allocator>(
+        std::forward<Args>(__args)...);
 }
 
 
@@ -222,8 +253,9 @@ template<__bencode_dict_template, typename ...Args>
 std::shared_ptr<basic_dict<__bencode_dict_typenames>>
 make_dict(Args&&... __args)
 {
-    return std::make_shared<basic_dict<
-        __bencode_dict_typenames>>(std::forward<Args>(__args)...);
+    return __detail::__allocate_value<basic_dict<
+        __bencode_dict_typenames>, Allocator>(
+        std::forward<Args>(__args)...);
 }
 
 
@@ -286,13 +318,79 @@ template<__bencode_list_template, typename ...Args>
 std::shared_ptr<basic_list<__bencode_list_typenames>>
 make_list(Args&&... __args)
 {
-    return std::shared_ptr<basic_list<
-        __bencode_list_typenames>>(std::forward<Args>(__args)...);
+    return __detail::__allocate_value<basic_list<
+        __bencode_list_typenames>, Allocator>(
+        std::forward<Args>(__args)...);
 }
 
 
 /**
- *  @brief Parse bencoded value.
+ *  @brief Access the value of the requested type.
+ *
+ *  @tparam T       Requested value type, for example `bencode::list`.
+ *  @tparam CharT   Character type.
+ *  @tparam Traits  Traits for character type.
+ *
+ *  @param __ptr  Pointer to the basic type.
+ *
+ *  Returns the pointer to the same value, when it is of the requested
+ *  type, otherwise `nullptr`. Nothing is copied.
+ */
+template <typename T, typename CharT, typename Traits>
+T*
+get_if(basic_value<CharT, Traits>* __ptr) noexcept
+{ return dynamic_cast<T*>(__ptr); }
+
+
+template <typename T, typename CharT, typename Traits>
+const T*
+get_if(const basic_value<CharT, Traits>* __ptr) noexcept
+{ return dynamic_cast<const T*>(__ptr); }
+
+
+/**
+ *  @brief Access the value of the requested type.
+ *
+ *  @tparam T       Requested value type, for example `bencode::list`.
+ *  @tparam CharT   Character type.
+ *  @tparam Traits  Traits for character type.
+ *
+ *  @param __ptr  Shared pointer to the basic type.
+ */
+template <typename T, typename CharT, typename Traits>
+T*
+get_if(const std::shared_ptr<basic_value<CharT, Traits>>& __ptr) noexcept
+{ return dynamic_cast<T*>(__ptr.get()); }
+
+
+/**
+ *  @brief Access the value of the requested type.
+ *
+ *  @tparam T       Requested value type, for example `bencode::dict`.
+ *  @tparam CharT   Character type.
+ *  @tparam Traits  Traits for character type.
+ *
+ *  @param __ptr  Shared pointer to the basic type.
+ *
+ *  Returns the reference to the same value without a copy. Throws
+ *  `type_error`, when the pointer is `nullptr` or the value is of the
+ *  different type.
+ */
+template <typename T, typename CharT, typename Traits>
+T&
+as(const std::shared_ptr<basic_value<CharT, Traits>>& __ptr)
+{
+    auto __value = get_if<T>(__ptr);
+    if (!__value) {
+        __bencode_throw(type_error("bencode::as the value is not of the "
+            "requested type\n"));
+    }
+    return *__value;
+}
+
+
+/**
+ *  @brief Decode bencoded value.
  *
  *  @tparam CharT          Character type, defaults to `char`.
  *  @tparam IntT           Integer type, defaults to `int64_t`.
@@ -301,16 +399,17 @@ make_list(Args&&... __args)
  *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
  *  @tparam ListContainer  List type, defaults to `std::vector`.
  *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *  @tparam Cursor         Input cursor type.
  *
- *  @param __s  Input stream.
+ *  @param __c  Input cursor.
  *
  *  Returns a shared pointer of the base value class. The pointer is
- *  storing the decoded value from the provided input stream. The target
- *  type is selected based on the first character of the input stream.
+ *  storing the decoded value from the provided cursor. The target type
+ *  is selected based on the current character of the cursor.
  */
-template<__bencode_dict_template>
+template<__bencode_dict_template, typename Cursor>
 std::shared_ptr<basic_value<CharT, Traits>>
-make_value(std::basic_istream<CharT, Traits> &__s)
+decode_value(Cursor& __c)
 {
     using basic_type = basic_value<CharT, Traits>;
 
@@ -320,30 +419,133 @@ make_value(std::basic_istream<CharT, Traits> &__s)
     using list_type = basic_list<__bencode_list_typenames>;
     using dict_type = basic_dict<__bencode_dict_typenames>;
 
-    std::shared_ptr<basic_type> __ptr;
-
-    // Based on the first character in the provided input stream,
-    // select the target parser type.
-    switch (__s.peek())
+    // Based on the current character of the provided cursor,
+    // select the target decoder type.
+    switch (__c.peek())
     {
-    case basic_type::integer_token:
-        __ptr = std::make_shared<integer_type>();
-        break;
-    case basic_type::list_token:
-        __ptr = std::make_shared<list_type>();
-        break;
-    case basic_type::dict_token:
-        __ptr = std::make_shared<dict_type>();
-        break;
-    default:
-        __ptr = std::make_shared<string_type>();
+    case basic_type::integer_token: {
+        auto __ptr = __detail::__allocate_value<integer_type, Allocator>();
+        __ptr->decode(__c);
+        return __ptr;
+    }
+    case basic_type::list_token: {
+        auto __ptr = __detail::__allocate_value<list_type, Allocator>();
+        __ptr->decode(__c);
+        return __ptr;
     }
+    case basic_type::dict_token: {
+        auto __ptr = __detail::__allocate_value<dict_type, Allocator>();
+        __ptr->decode(__c);
+        return __ptr;
+    }
+    default: {
+        auto __ptr = __detail::__allocate_value<string_type, Allocator>();
+        __ptr->decode(__c);
+        return __ptr;
+    }
+    }
+}
+
+
+/**
+ *  @brief Parse bencoded value.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *
+ *  @param __s  Input stream.
+ *
+ *  Returns a shared pointer of the base value class. The pointer is
+ *  storing the decoded value from the provided input stream. The target
+ *  type is selected based on the first character of the input stream.
+ */
+template<__bencode_dict_template>
+std::shared_ptr<basic_value<CharT, Traits>>
+make_value(std::basic_istream<CharT, Traits> &__s)
+{
+    basic_streambuf_cursor<CharT, Traits> __c(__s);
+    return decode_value<__bencode_dict_typenames>(__c);
+}
+
 
-    __ptr->load(__s);
-    return __ptr;
+/**
+ *  @brief Parse bencoded value from the contiguous range of characters.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *
+ *  @param __s  Start of the range.
+ *  @param __n  Count of characters in the range.
+ *
+ *  Returns a pair of the shared pointer to the decoded value and the
+ *  count of characters consumed from the range. The characters after
+ *  the first decoded value are left untouched.
+ */
+template<__bencode_dict_template>
+std::pair<std::shared_ptr<basic_value<CharT, Traits>>, std::size_t>
+parse(const CharT* __s, std::size_t __n)
+{
+    basic_buffer_cursor<CharT, Traits> __c(__s, __n);
+    auto __ptr = decode_value<__bencode_dict_typenames>(__c);
+    return std::make_pair(__ptr, __c.position());
 }
 
 
+/**
+ *  @brief Parse bencoded value from the contiguous range of characters.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *
+ *  @param __first  Start of the range.
+ *  @param __last   End of the range.
+ *
+ *  Returns a pair of the shared pointer to the decoded value and the
+ *  count of characters consumed from the range.
+ */
+template<__bencode_dict_template>
+std::pair<std::shared_ptr<basic_value<CharT, Traits>>, std::size_t>
+parse(const CharT* __first, const CharT* __last)
+{ return parse<__bencode_dict_typenames>(__first, __last - __first); }
+
+
+/**
+ *  @brief Parse bencoded value from the string of characters.
+ *
+ *  @tparam CharT          Character type, defaults to `char`.
+ *  @tparam IntT           Integer type, defaults to `int64_t`.
+ *  @tparam Traits         Traits for character type, defaults to
+ *                         `std::char_traits<CharT>`.
+ *  @tparam Allocator      Allocator type, defaults to `std::allocator`.
+ *  @tparam ListContainer  List type, defaults to `std::vector`.
+ *  @tparam DictContainer  Dictionary type, defaults to `std::map`.
+ *
+ *  @param __str  Source string.
+ *
+ *  Returns a pair of the shared pointer to the decoded value and the
+ *  count of characters consumed from the string.
+ */
+template<__bencode_dict_template, typename StringAlloc>
+std::pair<std::shared_ptr<basic_value<CharT, Traits>>, std::size_t>
+parse(const std::basic_string<CharT, Traits, StringAlloc>& __str)
+{ return parse<__bencode_dict_typenames>(__str.data(), __str.size()); }
+
+
 } // namespace bencode
 
 #endif // INCLUDE_bencode_value_hpp__
@@ -0,0 +1,121 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <cstring>
+#include <limits>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/algorithm.hpp>
+
+
+template <typename IntT, typename CharT>
+bencode::integer_errc
+decode(const std::basic_string<CharT>& s, IntT& value)
+{
+    return bencode::decode_integer(s.data(), s.data() + s.size(),
+        value);
+}
+
+
+BOOST_AUTO_TEST_SUITE(TestAlgorithm)
+
+
+BOOST_AUTO_TEST_CASE(test_decode_integer)
+{
+    BOOST_TEST_MESSAGE("--- Integers should be decoded from the "
+        "decimal digits.");
+    int64_t i1 = 0;
+
+    BOOST_CHECK(decode(std::string("0"), i1) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i1 == 0);
+
+    BOOST_CHECK(decode(std::string("7"), i1) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i1 == 7);
+
+    BOOST_CHECK(decode(std::string("12345678"), i1) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i1 == 12345678);
+
+    BOOST_CHECK(decode(std::string("-1234567890123456789"), i1) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i1 == -1234567890123456789LL);
+
+    BOOST_CHECK(decode(std::wstring(L"98765432109"), i1) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i1 == 98765432109LL);
+
+
+    BOOST_TEST_MESSAGE("--- Every prefix of the digits sequence should "
+        "be decoded equally by the scalar and word-wise paths.");
+    const char* digits = "31415926535897932";
+
+    for (std::size_t n = 1; n <= std::strlen(digits); ++n) {
+        std::string s(digits, n);
+        uint64_t u = 0;
+
+        BOOST_CHECK(decode(s, u) == bencode::integer_errc::success);
+        BOOST_CHECK(u == std::stoull(s));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(test_decode_integer_errors)
+{
+    BOOST_TEST_MESSAGE("--- Invalid integers should be rejected.");
+    int64_t i1 = 42;
+
+    BOOST_CHECK(decode(std::string(""), i1) ==
+        bencode::integer_errc::not_a_number);
+    BOOST_CHECK(decode(std::string("-"), i1) ==
+        bencode::integer_errc::not_a_number);
+    BOOST_CHECK(decode(std::string("12a45"), i1) ==
+        bencode::integer_errc::not_a_number);
+    BOOST_CHECK(decode(std::string("123456789x"), i1) ==
+        bencode::integer_errc::not_a_number);
+    BOOST_CHECK(decode(std::string("01"), i1) ==
+        bencode::integer_errc::leading_zero);
+    BOOST_CHECK(decode(std::string("-0"), i1) ==
+        bencode::integer_errc::negative_zero);
+    BOOST_CHECK(decode(std::string("-01"), i1) ==
+        bencode::integer_errc::leading_zero);
+    BOOST_CHECK(i1 == 42);
+
+
+    BOOST_TEST_MESSAGE("--- Overflow should be detected exactly for "
+        "the target integer type.");
+    int8_t i2 = 0;
+
+    BOOST_CHECK(decode(std::string("127"), i2) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i2 == 127);
+    BOOST_CHECK(decode(std::string("-128"), i2) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i2 == -128);
+    BOOST_CHECK(decode(std::string("128"), i2) ==
+        bencode::integer_errc::out_of_range);
+    BOOST_CHECK(decode(std::string("-129"), i2) ==
+        bencode::integer_errc::out_of_range);
+
+    uint64_t u3 = 0;
+
+    BOOST_CHECK(decode(std::string("18446744073709551615"), u3) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(u3 == std::numeric_limits<uint64_t>::max());
+    BOOST_CHECK(decode(std::string("18446744073709551616"), u3) ==
+        bencode::integer_errc::out_of_range);
+    BOOST_CHECK(decode(std::string("-1"), u3) ==
+        bencode::integer_errc::not_a_number);
+
+    int32_t i4 = 0;
+
+    BOOST_CHECK(decode(std::string("-2147483648"), i4) ==
+        bencode::integer_errc::success);
+    BOOST_CHECK(i4 == std::numeric_limits<int32_t>::min());
+    BOOST_CHECK(decode(std::string("2147483648"), i4) ==
+        bencode::integer_errc::out_of_range);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
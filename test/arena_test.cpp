@@ -0,0 +1,110 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/arena.hpp>
+
+
+// Count the allocations from the global heap.
+static std::size_t allocations = 0;
+
+
+// The replacements are kept out of line, so the compiler never pairs an
+// inlined std::free with the operator new seen at the call site.
+__attribute__((noinline)) void*
+operator new(std::size_t n)
+{
+    ++allocations;
+    if (auto p = std::malloc(n ? n : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+
+__attribute__((noinline)) void
+operator delete(void* p) noexcept
+{ std::free(p); }
+
+
+__attribute__((noinline)) void
+operator delete(void* p, std::size_t) noexcept
+{ std::free(p); }
+
+
+BOOST_AUTO_TEST_SUITE(TestArena)
+
+
+BOOST_AUTO_TEST_CASE(test_monotonic_arena)
+{
+    BOOST_TEST_MESSAGE("--- Allocations should be aligned.");
+    bencode::monotonic_arena arena(64);
+
+    auto p1 = arena.allocate(3, 1);
+    auto p2 = arena.allocate(8, 8);
+    BOOST_CHECK(reinterpret_cast<std::uintptr_t>(p2) % 8 == 0);
+    BOOST_CHECK(p1 != p2);
+
+
+    BOOST_TEST_MESSAGE("--- Arena should grow beyond the first chunk.");
+    auto p3 = arena.allocate(1000, 16);
+    BOOST_CHECK(reinterpret_cast<std::uintptr_t>(p3) % 16 == 0);
+    BOOST_CHECK(arena.used() == 1011);
+
+    arena.release();
+    BOOST_CHECK(arena.used() == 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_parse_arena)
+{
+    BOOST_TEST_MESSAGE("--- Whole document should be placed to the arena.");
+    std::string s1("d4:info:d5:files:ll1:ae3:abce6:length:i1024e"
+        "4:name:8:file.txte1:t:2:aae");
+    bencode::monotonic_arena arena(1 << 16);
+
+    auto before = allocations;
+    auto r1 = bencode::parse(s1.data(), s1.size(), arena);
+    auto count = allocations - before;
+
+    // The only allocation from the heap is the first chunk of the arena.
+    BOOST_CHECK(count == 1);
+    BOOST_CHECK(arena.used() > 0);
+    BOOST_CHECK(r1.second == s1.size());
+
+    std::ostringstream ss;
+    r1.first->dump(ss);
+    BOOST_CHECK(ss.str() == s1);
+
+
+    BOOST_TEST_MESSAGE("--- Values should keep the resource.");
+    auto dict = std::dynamic_pointer_cast<bencode::arena_dict>(r1.first);
+    BOOST_REQUIRE(dict != nullptr);
+
+    before = allocations;
+    {
+        bencode::arena_scope scope(arena);
+        dict->insert(bencode::arena_dict::value_type(
+            bencode::arena_string("z"),
+            bencode::make_integer<char, int64_t, std::char_traits<char>,
+                bencode::arena_allocator>(int64_t(1))));
+    }
+    BOOST_CHECK(allocations - before == 0);
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "malformed value.");
+    std::string s2("li1e");
+    BOOST_CHECK_THROW(bencode::parse(s2.data(), s2.size(), arena),
+        bencode::encoding_error);
+
+    // The scope of the arena is left after the exception.
+    BOOST_CHECK(bencode::arena_allocator<char>().resource() == nullptr);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,81 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/canonical.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestCanonical)
+
+
+BOOST_AUTO_TEST_CASE(test_is_canonical)
+{
+    BOOST_TEST_MESSAGE("--- Canonical values should be accepted.");
+    std::string values[] = {
+        "i0e", "4:spam", "de", "d1:a:i1e1:b:i2ee",
+        "d1:a:d1:a:i1e1:b:i2ee1:b:d1:a:i1eee",
+        "d0::i0e1:a:i1e2:aa:i2e1:b:i3ee",
+        "l" "d1:b:i1e1:c:i2ee" "d1:a:i1e1:b:i2ee" "e",
+    };
+
+    for (auto& s : values) {
+        BOOST_CHECK_MESSAGE(bencode::is_canonical(s), s);
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Keys should be compared as raw bytes.");
+    std::string s1("d1:a:i1e1:\xff:i2ee");
+    BOOST_CHECK(bencode::is_canonical(s1));
+
+
+    BOOST_TEST_MESSAGE("--- Violations should be reported.");
+    auto r2 = bencode::is_canonical(std::string("d1:b:i1e1:a:i2ee"));
+    BOOST_CHECK(r2.code == bencode::errc::unsorted_keys);
+    BOOST_CHECK(r2.offset == 8);
+
+    auto r3 = bencode::is_canonical(std::string("d1:a:d1:a:i1e1:a:i2eee"));
+    BOOST_CHECK(r3.code == bencode::errc::duplicate_key);
+    BOOST_CHECK(r3.offset == 13);
+
+    auto r4 = bencode::is_canonical(std::string("d1:a:i01ee"));
+    BOOST_CHECK(r4.code == bencode::errc::leading_zero);
+
+    auto r5 = bencode::is_canonical(std::string("d2:aa:i1e1:a:i2ee"));
+    BOOST_CHECK(r5.code == bencode::errc::unsorted_keys);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_canonicalize)
+{
+    BOOST_TEST_MESSAGE("--- Canonical value should be copied verbatim.");
+    std::string s1("d1:a:li1e3:abce1:b:i2ee");
+    BOOST_CHECK(bencode::canonicalize(s1) == s1);
+
+
+    BOOST_TEST_MESSAGE("--- Keys should be sorted.");
+    std::string s2("d1:c:i3e1:a:li1ed1:z:0:1:y:0:ee1:b:i2ee");
+    BOOST_CHECK(bencode::canonicalize(s2) ==
+        "d1:a:li1ed1:y:0:1:z:0:ee1:b:i2e1:c:i3ee");
+
+
+    BOOST_TEST_MESSAGE("--- First value of the duplicate key should "
+        "be kept.");
+    std::string s3("d1:b:i1e1:a:i2e1:b:i3ee");
+    BOOST_CHECK(bencode::canonicalize(s3) == "d1:a:i2e1:b:i1ee");
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "malformed value.");
+    std::string s4("d1:b:i1e1:a:i02ee");
+    BOOST_CHECK_EXCEPTION(bencode::canonicalize(s4),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::canonicalize redundant leading zero at offset 13");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,88 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <boost/test/unit_test.hpp>
+#include <bencode/decode.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestDecode)
+
+
+BOOST_AUTO_TEST_CASE(test_try_parse)
+{
+    auto dump = [](const std::shared_ptr<bencode::basic_value<char>>& value) {
+        std::ostringstream ss;
+        value->dump(ss);
+        return ss.str();
+    };
+
+
+    BOOST_TEST_MESSAGE("--- Values should be decoded without exceptions.");
+    std::string s1("d1:a:li1e3:abcd1:b:leee1:c:0:e4:tail");
+    auto r1 = bencode::try_parse(s1.data(), s1.size());
+
+    BOOST_REQUIRE(r1);
+    BOOST_CHECK(!r1.error());
+    BOOST_CHECK(r1.offset == s1.size() - 6);
+    BOOST_CHECK(dump(r1.value) == s1.substr(0, r1.offset));
+
+    std::string s2("i-42e");
+    auto r2 = bencode::try_parse(s2.data(), s2.size());
+    BOOST_CHECK(bencode::integer(r2.value) == int64_t(-42));
+
+    std::string s3("4:spam");
+    auto r3 = bencode::try_parse(s3.data(), s3.size());
+    BOOST_CHECK(bencode::string(r3.value) == "spam");
+
+
+    BOOST_TEST_MESSAGE("--- First value of the duplicate key should "
+        "be kept.");
+    std::string s4("d1:a:i1e1:a:i2ee");
+    auto r4 = bencode::try_parse(s4.data(), s4.size());
+    BOOST_CHECK(dump(r4.value) == "d1:a:i1ee");
+
+
+    BOOST_TEST_MESSAGE("--- Kind and offset of the error should "
+        "be reported.");
+    std::string s5("d1:a:i01ee");
+    auto r5 = bencode::try_parse(s5.data(), s5.size());
+
+    BOOST_CHECK(!r5);
+    BOOST_CHECK(r5.value == nullptr);
+    BOOST_CHECK(r5.code == bencode::errc::leading_zero);
+    BOOST_CHECK(r5.offset == 6);
+
+    std::string s6("llli1eee");
+    auto r6 = bencode::try_parse(s6.data(), s6.size(), 2);
+    BOOST_CHECK(r6.code == bencode::errc::depth_exceeded);
+    BOOST_CHECK(r6.offset == 2);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_parse_error_code)
+{
+    BOOST_TEST_MESSAGE("--- Error code should be cleared on success.");
+    std::string s1("li1ei2ee");
+    std::error_code ec = bencode::errc::invalid_key;
+
+    auto r1 = bencode::parse(s1.data(), s1.size(), ec);
+    BOOST_CHECK(!ec);
+    BOOST_CHECK(r1.second == s1.size());
+    BOOST_CHECK(bencode::list(r1.first).size() == 2);
+
+
+    BOOST_TEST_MESSAGE("--- Error code should be set on error.");
+    std::string s2("li1e");
+    auto r2 = bencode::parse(s2.data(), s2.size(), ec);
+
+    BOOST_CHECK(ec == bencode::errc::unexpected_end);
+    BOOST_CHECK(ec.message() == "unexpected end of the value");
+    BOOST_CHECK(r2.first == nullptr);
+    BOOST_CHECK(r2.second == 4);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
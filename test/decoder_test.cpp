@@ -0,0 +1,142 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/decoder.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestDecoder)
+
+
+BOOST_AUTO_TEST_CASE(test_decode)
+{
+    auto dump = [](const std::shared_ptr<bencode::basic_value<char>>& value) {
+        std::ostringstream ss;
+        value->dump(ss);
+        return ss.str();
+    };
+
+    bencode::decoder d;
+
+
+    BOOST_TEST_MESSAGE("--- Nested values should be decoded.");
+    std::string s1("d1:a:li1e3:abcd1:b:leee1:c:0:ei2e");
+    auto r1 = d.parse(s1.data(), s1.size());
+
+    BOOST_CHECK(r1.second == s1.size() - 3);
+    BOOST_CHECK(dump(r1.first) == s1.substr(0, r1.second));
+
+
+    BOOST_TEST_MESSAGE("--- Scalar values should be decoded.");
+    std::string s2("i-42e");
+    BOOST_CHECK(bencode::integer(d.parse(s2.data(), s2.size()).first)
+        == int64_t(-42));
+
+    std::string s3("4:spam");
+    BOOST_CHECK(bencode::string(d.parse(s3.data(), s3.size()).first)
+        == "spam");
+
+
+    BOOST_TEST_MESSAGE("--- Value should be decoded from the stream.");
+    std::stringstream ss4("ld1:a:i1eei2ee4:tail");
+    auto r4 = d.load(ss4);
+
+    BOOST_CHECK(dump(r4) == "ld1:a:i1eei2ee");
+    BOOST_CHECK(ss4.peek() == '4');
+
+
+    BOOST_TEST_MESSAGE("--- First value of the duplicate key should "
+        "be kept.");
+    std::string s5("d1:a:i1e1:a:i2ee");
+    BOOST_CHECK(dump(d.parse(s5.data(), s5.size()).first) == "d1:a:i1ee");
+
+
+    BOOST_TEST_MESSAGE("--- Deeply nested values should be decoded "
+        "without the recursion.");
+    std::string s6(10000, 'l');
+    s6 += std::string(10000, 'e');
+
+    bencode::decoder d6(10000);
+    auto r6 = d6.parse(s6.data(), s6.size());
+    BOOST_CHECK(r6.second == s6.size());
+
+    // Unwind the value manually to avoid the deep recursion of the
+    // destructors.
+    auto value = r6.first;
+    r6.first = nullptr;
+    while (value) {
+        bencode::list l(value);
+        value = l.size() ? l[0] : nullptr;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(test_decode_exceptions)
+{
+    bencode::decoder d(16);
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised when the nesting "
+        "depth is exceeded.");
+    std::string s1(100000, 'l');
+
+    BOOST_CHECK(d.max_depth() == 16);
+    BOOST_CHECK_EXCEPTION(d.parse(s1.data(), s1.size()),
+        bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::decoder the nesting depth exceeds the limit "
+                "of 16 at offset 16");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "unterminated dictionary.");
+    std::string s2("d1:a:i1e");
+
+    BOOST_CHECK_EXCEPTION(d.parse(s2.data(), s2.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the end of the dictionary `e` expected");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the missing "
+        "delimiter.");
+    std::string s3("d1:ai1ee");
+
+    BOOST_CHECK_EXCEPTION(d.parse(s3.data(), s3.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "after the key a `:` delimiter expected, but `i` found");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the key "
+        "without the value.");
+    for (std::string s : {"d1:a:e", "ld1:a:ee", "d1:a:i1e1:b:e"}) {
+        BOOST_CHECK_EXCEPTION(d.parse(s.data(), s.size()),
+            bencode::encoding_error,
+            [](bencode::encoding_error const& exception) {
+                auto pos = std::string(exception.what()).find(
+                    "the value of the key expected, but `e` found");
+                return pos != std::string::npos;
+            });
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Decoder should be reused after the error.");
+    std::string s4("li1ee");
+    bencode::list l4(d.parse(s4.data(), s4.size()).first);
+    BOOST_CHECK(l4.size() == 1);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -109,4 +109,28 @@ BOOST_AUTO_TEST_CASE(test_dump)
 }
 
 
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    BOOST_TEST_MESSAGE("--- Dictionary value should be moved without "
+        "copying the items.");
+    bencode::dict d1;
+    auto item = bencode::make_string("value");
+
+    d1.insert(bencode::dict::value_type("key", item));
+    bencode::dict d2(std::move(d1));
+    BOOST_CHECK(d1.size() == 0);
+    BOOST_CHECK(d2["key"] == item);
+
+
+    BOOST_TEST_MESSAGE("--- Decoded dictionary should be accessed "
+        "in place.");
+    std::stringstream ss1("d5:files:li1eee");
+    auto ptr = bencode::make_value(ss1);
+
+    auto& files = bencode::as<bencode::dict>(ptr)["files"];
+    BOOST_CHECK(bencode::get_if<bencode::list>(files)->size() == 1);
+    BOOST_CHECK(bencode::get_if<bencode::string>(files) == nullptr);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
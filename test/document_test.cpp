@@ -0,0 +1,84 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bencode/document.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestDocument)
+
+
+BOOST_AUTO_TEST_CASE(test_parse)
+{
+    BOOST_TEST_MESSAGE("--- Document should be decoded from the "
+        "character buffer.");
+    std::string s1("d4:name:8:manifold6:length:i-1024e"
+        "5:files:ld4:path:3:abce0:lee4:last:i7ee");
+    bencode::document d1(s1);
+    auto r1 = d1.root();
+
+    BOOST_CHECK(r1.type() == bencode::tape_type::dict);
+    BOOST_CHECK(r1.size() == 4);
+    BOOST_CHECK(r1["name"].string() == "manifold");
+    BOOST_CHECK(r1["length"].integer() == -1024);
+    BOOST_CHECK(r1["last"].integer() == 7);
+
+    auto f1 = r1["files"];
+    BOOST_CHECK(f1.type() == bencode::tape_type::list);
+    BOOST_CHECK(f1.size() == 3);
+    BOOST_CHECK(f1[0]["path"].string() == "abc");
+    BOOST_CHECK(f1[1].string() == "");
+    BOOST_CHECK(f1[2].size() == 0);
+    BOOST_CHECK(r1.find("missing") == r1.end());
+
+
+    BOOST_TEST_MESSAGE("--- Dictionary items should be iterated in "
+        "the order of the encoding.");
+    std::vector<std::string> keys;
+    for (auto it = r1.begin(); it != r1.end(); ++it) {
+        keys.push_back(it.key().string());
+    }
+
+    std::vector<std::string> e1{"name", "length", "files", "last"};
+    BOOST_CHECK_EQUAL_COLLECTIONS(keys.begin(), keys.end(),
+        e1.begin(), e1.end());
+
+
+    BOOST_TEST_MESSAGE("--- Document should keep only the first "
+        "value of the buffer.");
+    std::wstring s2(L"li1e3:абвei2e");
+    bencode::wdocument d2(s2);
+
+    BOOST_CHECK(d2.source() == L"li1e3:абвe");
+    BOOST_CHECK(d2.root()[0].integer() == 1);
+    BOOST_CHECK(d2.root()[1].string() == L"абв");
+    BOOST_CHECK(d2.tape().size() == 6);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "malformed document.");
+    std::string s1("d4:name:8:manifold");
+    bencode::document d1;
+
+    BOOST_CHECK_THROW(d1.parse(s1.data(), s1.size()),
+        bencode::encoding_error);
+    BOOST_CHECK(d1.empty());
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the access "
+        "to the value of other type.");
+    bencode::document d2(std::string("li1ee"));
+
+    BOOST_CHECK_THROW(d2.root().integer(), bencode::type_error);
+    BOOST_CHECK_THROW(d2.root()[0].string(), bencode::type_error);
+    BOOST_CHECK_THROW(d2.root()[1], bencode::value_error);
+    BOOST_CHECK_THROW(d2.root()["key"], bencode::type_error);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
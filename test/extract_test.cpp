@@ -0,0 +1,103 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bencode/extract.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestExtract)
+
+
+BOOST_AUTO_TEST_CASE(test_extract)
+{
+    BOOST_TEST_MESSAGE("--- Values should be extracted by the paths.");
+    std::string s1("d8:announce:3:url4:info:d5:files:ld6:length:i3e"
+        "4:path:l1:aeed6:length:i5e4:path:l1:beee4:name:8:manifold"
+        "12:piece length:i16384e6:pieces:4:\x01\x02\x03\x04" "ee");
+
+    bencode::extractor e1;
+    std::string name;
+    int64_t piece_length = 0;
+    std::vector<int64_t> lengths;
+
+    e1.bind("info/name", name);
+    e1.bind("info/piece length", piece_length);
+    e1.on("info/files/*/length", [&](const bencode::path_match& m) {
+        BOOST_CHECK(m.path() == 2);
+        lengths.push_back(m.integer());
+    });
+
+    BOOST_CHECK(e1.extract(s1) == s1.size());
+    BOOST_CHECK(name == "manifold");
+    BOOST_CHECK(piece_length == 16384);
+    BOOST_CHECK(lengths == std::vector<int64_t>({3, 5}));
+
+
+    BOOST_TEST_MESSAGE("--- List indices and containers should "
+        "be matched.");
+    bencode::extractor e2;
+    std::string path;
+    std::string raw;
+
+    e2.bind("info/files/1/path/0", path);
+    e2.on("info/files/0", [&](const bencode::path_match& m) {
+        BOOST_CHECK(m.type() == bencode::tape_type::dict);
+        raw.assign(m.first(), m.last());
+    });
+
+    e2.extract(s1);
+    BOOST_CHECK(path == "b");
+    BOOST_CHECK(raw == "d6:length:i3e4:path:l1:aee");
+
+
+    BOOST_TEST_MESSAGE("--- Empty path should match the root value.");
+    bencode::extractor e3;
+    std::size_t count = 0;
+
+    e3.on("", [&](const bencode::path_match& m) {
+        BOOST_CHECK(m.type() == bencode::tape_type::integer);
+        BOOST_CHECK(m.integer() == -7);
+        ++count;
+    });
+
+    BOOST_CHECK(e3.extract(std::string("i-7e")) == 4);
+    BOOST_CHECK(count == 1);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_extract_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "malformed skipped value.");
+    std::string s1("d1:a:i01e1:b:i1ee");
+    bencode::extractor e1;
+    int64_t b = 0;
+
+    e1.bind("b", b);
+    BOOST_CHECK_EXCEPTION(e1.extract(s1), bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "invalid integer at offset 6");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "value of the unexpected type.");
+    std::string s2("d1:a:i1ee");
+    bencode::extractor e2;
+    std::string a;
+
+    e2.bind("a", a);
+    BOOST_CHECK_EXCEPTION(e2.extract(s2), bencode::type_error,
+        [](bencode::type_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the value is not a string");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
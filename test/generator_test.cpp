@@ -0,0 +1,88 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bencode/generator.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestGenerator)
+
+
+BOOST_AUTO_TEST_CASE(test_generate)
+{
+    BOOST_TEST_MESSAGE("--- Elements should be generated from the buffer.");
+    std::string s1("li1ed3:key:i2ee3:abce");
+    bencode::list_generator g1(s1.data(), s1.size());
+
+    auto v1 = g1.next();
+    BOOST_CHECK(bencode::integer(v1) == int64_t(1));
+    BOOST_CHECK(g1.position() == 4);
+
+    bencode::dict d1(g1.next());
+    BOOST_CHECK(bencode::integer(d1["key"]) == int64_t(2));
+    BOOST_CHECK(bencode::string(g1.next()) == "abc");
+    BOOST_CHECK(g1.next() == nullptr);
+    BOOST_CHECK(g1.done());
+    BOOST_CHECK(g1.position() == s1.size());
+
+
+    BOOST_TEST_MESSAGE("--- Elements should be generated from the stream.");
+    std::stringstream ss2("li1ei2ei3ei4eei5e");
+    bencode::stream_list_generator g2(ss2);
+    std::vector<int64_t> values;
+
+    for (auto& value : g2) {
+        values.push_back(bencode::integer(value));
+    }
+    BOOST_CHECK(values == std::vector<int64_t>({1, 2, 3, 4}));
+    BOOST_CHECK(ss2.peek() == 'i');
+
+
+    BOOST_TEST_MESSAGE("--- Generation should be stopped early.");
+    std::stringstream ss3("li1ei2ei3ee");
+    bencode::stream_list_generator g3(ss3);
+
+    for (auto& value : g3) {
+        if (bencode::integer(value) == int64_t(2)) {
+            break;
+        }
+    }
+    BOOST_CHECK(!g3.done());
+    BOOST_CHECK(ss3.peek() == 'i');
+}
+
+
+BOOST_AUTO_TEST_CASE(test_generate_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the value "
+        "of the different type.");
+    std::string s1("i1e");
+
+    BOOST_CHECK_EXCEPTION(bencode::list_generator(s1.data(), s1.size()),
+        bencode::type_error,
+        [](bencode::type_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "does not contain interpretable bencode list value");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "unterminated list.");
+    std::string s2("li1e");
+    bencode::list_generator g2(s2.data(), s2.size());
+
+    g2.next();
+    BOOST_CHECK_EXCEPTION(g2.next(), bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the end of the list `e` expected");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
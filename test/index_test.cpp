@@ -0,0 +1,98 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bencode/index.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestIndex)
+
+
+BOOST_AUTO_TEST_CASE(test_index_structure)
+{
+    BOOST_TEST_MESSAGE("--- Structural symbols should be indexed.");
+    std::string s1("d4:name:5:li1ee6:pieces:li3ei-14eee");
+    auto i1 = bencode::index_structure(s1.data(), s1.size());
+
+    std::vector<std::size_t> e1{0, 1, 8, 15, 24, 25, 28, 33, 34};
+    BOOST_CHECK_EQUAL_COLLECTIONS(i1.begin(), i1.end(),
+        e1.begin(), e1.end());
+
+
+    BOOST_TEST_MESSAGE("--- Only the first value should be indexed.");
+    std::string s2("le0:i7e");
+    std::vector<std::size_t> i2;
+
+    BOOST_CHECK(bencode::index_structure(s2.data(), s2.data() + s2.size(),
+        i2) == 2);
+    BOOST_CHECK(i2.size() == 2);
+
+
+    BOOST_TEST_MESSAGE("--- Wide characters should be indexed.");
+    std::wstring s3(L"l3:абвi0ee");
+    auto i3 = bencode::index_structure(s3.data(), s3.size());
+
+    std::vector<std::size_t> e3{0, 1, 6, 9};
+    BOOST_CHECK_EQUAL_COLLECTIONS(i3.begin(), i3.end(),
+        e3.begin(), e3.end());
+}
+
+
+BOOST_AUTO_TEST_CASE(test_index_structure_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "unbalanced containers.");
+    std::string s1("ld1:a:i1ee");
+
+    BOOST_CHECK_EXCEPTION(bencode::index_structure(s1.data(), s1.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "unexpected end of the value at offset 10");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the string "
+        "exceeding the range.");
+    std::string s2("l9:tinye");
+
+    BOOST_CHECK_EXCEPTION(bencode::index_structure(s2.data(), s2.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "unexpected end of the string at offset 8");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "invalid integer.");
+    std::string s3("li03ee");
+
+    BOOST_CHECK_EXCEPTION(bencode::index_structure(s3.data(), s3.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "invalid integer at offset 2");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "value used as a key.");
+    std::string s4("di1e:i2ee");
+
+    BOOST_CHECK_EXCEPTION(bencode::index_structure(s4.data(), s4.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the delimiter `:` expected at offset 1");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
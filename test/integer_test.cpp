@@ -1,6 +1,7 @@
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE Bencode
 
+#include <limits>
 #include <sstream>
 #include <boost/test/unit_test.hpp>
 #include <bencode.hpp>
@@ -43,6 +44,16 @@ BOOST_AUTO_TEST_CASE(test_load)
 
     i4.load(ss4);
     BOOST_CHECK(i4 == int64_t(1864795134));
+
+
+    BOOST_TEST_MESSAGE("--- Boundary values should be decoded.");
+    std::stringstream ss5("i9223372036854775807ei-9223372036854775808e");
+    bencode::integer i5, i6;
+
+    i5.load(ss5);
+    i6.load(ss5);
+    BOOST_CHECK(i5 == std::numeric_limits<int64_t>::max());
+    BOOST_CHECK(i6 == std::numeric_limits<int64_t>::min());
 }
 
 
@@ -98,6 +109,45 @@ BOOST_AUTO_TEST_CASE(test_load_exceptions)
                 "the specified value is not a number");
             return pos != std::string::npos;
         });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on "
+        "leading zeros of the integer value.");
+    std::stringstream ss6("i0042e");
+    bencode::integer i6;
+
+    BOOST_CHECK_EXCEPTION(i6.load(ss6), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the specified value has redundant leading zeros");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on "
+        "negative zero integer value.");
+    std::stringstream ss7("i-0e");
+    bencode::integer i7;
+
+    BOOST_CHECK_EXCEPTION(i7.load(ss7), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the specified value is a negative zero");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on "
+        "integer value overflow.");
+    std::stringstream ss8("i9223372036854775808e");
+    bencode::integer i8;
+
+    BOOST_CHECK_EXCEPTION(i8.load(ss8), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the specified value is out of range of the integer type");
+            return pos != std::string::npos;
+        });
 }
 
 
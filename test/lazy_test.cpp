@@ -0,0 +1,163 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/lazy.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestLazy)
+
+
+BOOST_AUTO_TEST_CASE(test_parse_dict)
+{
+    BOOST_TEST_MESSAGE("--- Lazy dictionary should decode the values "
+        "on access.");
+    std::string s1("d4:info:d4:name:8:manifold5:files:ld6:length:i3ee"
+        "d6:length:i5eeee7:comment:4:none6:length:i1024ee!");
+    bencode::lazy_dict d1;
+
+    BOOST_CHECK(d1.parse(s1.data(), s1.size()) == s1.size() - 1);
+    BOOST_CHECK(d1.size() == 3);
+    BOOST_CHECK(d1.count("info") == 1);
+    BOOST_CHECK(bencode::integer(d1["length"]) == int64_t(1024));
+    BOOST_CHECK(bencode::string(d1["comment"]) == "none");
+
+    bencode::lazy_dict info(d1["info"]);
+    BOOST_CHECK(bencode::string(info["name"]) == "manifold");
+
+    bencode::lazy_list files(info["files"]);
+    BOOST_CHECK(files.size() == 2);
+
+    bencode::lazy_dict file(files[1]);
+    BOOST_CHECK(bencode::integer(file["length"]) == int64_t(5));
+
+
+    BOOST_TEST_MESSAGE("--- Lazy dictionary should iterate over the "
+        "items in the order of the keys.");
+    std::string s2("d1:a:i1e1:b:5:value1:c:li2eee");
+    bencode::lazy_dict d2;
+    std::string keys;
+
+    d2.parse(s2.data(), s2.size());
+    for (auto it = d2.begin(); it != d2.end(); ++it) {
+        keys += it.key();
+        BOOST_CHECK(it.value() != nullptr);
+    }
+    BOOST_CHECK(keys == "abc");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_parse_list)
+{
+    BOOST_TEST_MESSAGE("--- Lazy list should decode the elements "
+        "on access.");
+    std::string s1("li1e3:twol5:threeei4ee");
+    bencode::lazy_list l1;
+
+    BOOST_CHECK(l1.parse(s1.data(), s1.size()) == s1.size());
+    BOOST_CHECK(l1.size() == 4);
+    BOOST_CHECK(bencode::integer(l1[3]) == int64_t(4));
+    BOOST_CHECK(bencode::string(l1[1]) == "two");
+
+    std::size_t count = 0;
+    for (auto& value : l1) {
+        BOOST_CHECK(value != nullptr);
+        ++count;
+    }
+    BOOST_CHECK(count == 4);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_dump)
+{
+    BOOST_TEST_MESSAGE("--- Untouched values should be dumped as they "
+        "were encoded.");
+    std::string s1("d5:first:li1ei2ee6:second:d1:x:i3eee");
+    bencode::lazy_dict d1;
+    std::stringstream ss1;
+
+    d1.parse(s1.data(), s1.size());
+    d1.dump(ss1);
+    BOOST_CHECK(ss1.str() == s1);
+
+
+    BOOST_TEST_MESSAGE("--- Updated values should be dumped.");
+    std::stringstream ss2;
+
+    d1["first"] = bencode::make_integer(7);
+    d1.dump(ss2);
+    BOOST_CHECK(ss2.str() == "d5:first:i7e6:second:d1:x:i3eee");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_load)
+{
+    BOOST_TEST_MESSAGE("--- Lazy dictionary should be loaded from "
+        "the stream.");
+    std::stringstream ss1("d3:key:l4:spame5:other:i42eei7e");
+    bencode::lazy_dict d1;
+
+    d1.load(ss1);
+    BOOST_CHECK(d1.size() == 2);
+    BOOST_CHECK(bencode::integer(d1["other"]) == int64_t(42));
+    BOOST_CHECK(ss1.peek() == 'i');
+
+
+    BOOST_TEST_MESSAGE("--- Lazy list should be loaded from the stream.");
+    std::stringstream ss2("l3:abci-1ee");
+    bencode::lazy_list l2;
+
+    l2.load(ss2);
+    BOOST_CHECK(l2.size() == 2);
+    BOOST_CHECK(bencode::integer(l2[1]) == int64_t(-1));
+}
+
+
+BOOST_AUTO_TEST_CASE(test_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "malformed value of the dictionary.");
+    std::string s1("d3:key:i01ee");
+    bencode::lazy_dict d1;
+
+    BOOST_CHECK_EXCEPTION(d1.parse(s1.data(), s1.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::lazy_dict::parse invalid integer at offset 8");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "truncated list.");
+    std::string s3("li1e");
+    bencode::lazy_list l3;
+
+    BOOST_CHECK_EXCEPTION(l3.parse(s3.data(), s3.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::lazy_list::parse unexpected end of the value");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "value of the different type.");
+    std::string s2("li1ee");
+    bencode::lazy_dict d2;
+
+    BOOST_CHECK_EXCEPTION(d2.parse(s2.data(), s2.size()),
+        bencode::type_error,
+        [](bencode::type_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "does not contain interpretable bencode dictionary");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
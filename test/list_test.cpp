@@ -79,4 +79,50 @@ BOOST_AUTO_TEST_CASE(test_dump)
 }
 
 
+BOOST_AUTO_TEST_CASE(test_move)
+{
+    BOOST_TEST_MESSAGE("--- List value should be moved without copying "
+        "the elements.");
+    bencode::list l1;
+    auto item = bencode::make_integer(42);
+
+    l1.insert(item);
+    bencode::list l2(std::move(l1));
+    BOOST_CHECK(l1.size() == 0);
+    BOOST_CHECK(l2.size() == 1);
+    BOOST_CHECK(l2[0] == item);
+
+    l1 = std::move(l2);
+    BOOST_CHECK(l1[0] == item);
+
+
+    BOOST_TEST_MESSAGE("--- Decoded list should be accessed in place.");
+    std::stringstream ss1("li1e3:abce");
+    auto ptr = bencode::make_value(ss1);
+
+    auto& l3 = bencode::as<bencode::list>(ptr);
+    BOOST_CHECK(&l3 == ptr.get());
+    BOOST_CHECK(bencode::get_if<bencode::list>(ptr) == &l3);
+    BOOST_CHECK(bencode::get_if<bencode::dict>(ptr) == nullptr);
+
+    l3.insert(bencode::make_integer(2));
+    BOOST_CHECK(bencode::as<bencode::list>(ptr).size() == 3);
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the wrong type.");
+    BOOST_CHECK_EXCEPTION(bencode::as<bencode::dict>(ptr),
+        bencode::type_error,
+        [](bencode::type_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::as the value is not of the requested type");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- List should be created by the helper.");
+    auto l4 = bencode::make_list(std::size_t(2));
+    BOOST_CHECK(l4->size() == 2);
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
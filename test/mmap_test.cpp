@@ -0,0 +1,63 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <boost/test/unit_test.hpp>
+#include <bencode/mmap.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestMmap)
+
+
+BOOST_AUTO_TEST_CASE(test_map_file)
+{
+    BOOST_TEST_MESSAGE("--- Document should be decoded from the "
+        "mapped file.");
+    const char* path = "mmap_test.bencode";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << "d4:name:8:manifold6:length:i1024ee";
+    }
+
+    bencode::document d1;
+    {
+        auto d = bencode::map_file(path);
+        d1 = d;
+    }
+    std::remove(path);
+
+    auto root = d1.root();
+    BOOST_CHECK(root["name"].string() == "manifold");
+    BOOST_CHECK(root["length"].integer() == 1024);
+    BOOST_CHECK(d1.size() == 34);
+
+    // The strings should refer to the mapped pages.
+    BOOST_CHECK(root["name"].data() == d1.data() + 10);
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "missing file.");
+    BOOST_CHECK_EXCEPTION(bencode::map_file("mmap_test.missing"),
+        std::system_error,
+        [](std::system_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::map_file failed to open `mmap_test.missing`");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "empty file.");
+    {
+        std::ofstream os(path, std::ios::binary);
+    }
+
+    BOOST_CHECK_THROW(bencode::map_file(path), bencode::encoding_error);
+    std::remove(path);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,132 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <boost/test/unit_test.hpp>
+#include <bencode/node.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestNode)
+
+
+BOOST_AUTO_TEST_CASE(test_node)
+{
+    auto dump = [](const bencode::node& n) {
+        std::ostringstream ss;
+        n.dump(ss);
+        return ss.str();
+    };
+
+
+    BOOST_TEST_MESSAGE("--- Scalars should be kept inline.");
+    bencode::node n1(int64_t(-7));
+    BOOST_CHECK(n1.type() == bencode::node_type::integer);
+    BOOST_CHECK(n1.integer() == int64_t(-7));
+    BOOST_CHECK(dump(n1) == "i-7e");
+
+    bencode::node n2("spam");
+    BOOST_CHECK(n2.is_string());
+    BOOST_CHECK(n2.string() == "spam");
+    BOOST_CHECK(dump(n2) == "4:spam");
+
+
+    BOOST_TEST_MESSAGE("--- Keys of the dictionary should be sorted.");
+    bencode::node n3(bencode::node::dict_type{});
+    n3["b"] = bencode::node(bencode::node::list_type{});
+    n3["b"].push_back(int64_t(1));
+    n3["b"].push_back("abc");
+    n3["a"] = int64_t(2);
+
+    BOOST_CHECK(n3.size() == 2);
+    BOOST_CHECK(n3.find("a")->integer() == int64_t(2));
+    BOOST_CHECK(n3.find("c") == nullptr);
+    BOOST_CHECK(!n3.insert("a", int64_t(3)).second);
+    BOOST_CHECK(dump(n3) == "d1:a:i2e1:b:li1e3:abcee");
+
+
+    BOOST_TEST_MESSAGE("--- Copies should be independent.");
+    bencode::node n4(n3);
+    n4["a"] = "x";
+    BOOST_CHECK(n4 != n3);
+    BOOST_CHECK(n3["a"].integer() == int64_t(2));
+
+    bencode::node n5(std::move(n4));
+    BOOST_CHECK(n5["a"].string() == "x");
+    n5 = n3;
+    BOOST_CHECK(n5 == n3);
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the wrong type.");
+    BOOST_CHECK_EXCEPTION(n1.string(),
+        bencode::type_error,
+        [](bencode::type_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::node the value is not a string");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_CASE(test_parse_node)
+{
+    auto dump = [](const bencode::node& n) {
+        std::ostringstream ss;
+        n.dump(ss);
+        return ss.str();
+    };
+
+
+    BOOST_TEST_MESSAGE("--- Values should be decoded into the node.");
+    std::string s1("d1:a:li1e3:abcd1:b:leee1:c:0:e4:tail");
+    auto r1 = bencode::parse_node(s1.data(), s1.size());
+
+    BOOST_CHECK(r1.second == s1.size() - 6);
+    BOOST_CHECK(dump(r1.first) == s1.substr(0, r1.second));
+    BOOST_CHECK(r1.first["a"][1].string() == "abc");
+    BOOST_CHECK(r1.first["a"][2]["b"].size() == 0);
+
+
+    BOOST_TEST_MESSAGE("--- Keys should be sorted and the first value of "
+        "the duplicate key should be kept.");
+    std::string s2("d1:b:i1e1:a:li2ee1:b:d1:x:i3eee");
+    auto r2 = bencode::parse_node(s2.data(), s2.size());
+    BOOST_CHECK(dump(r2.first) == "d1:a:li2ee1:b:i1ee");
+
+
+    BOOST_TEST_MESSAGE("--- Errors should be reported.");
+    std::string s3("li1ei02ee");
+    std::error_code ec;
+    auto r3 = bencode::parse_node(s3.data(), s3.size(), ec);
+    BOOST_CHECK(ec == bencode::errc::leading_zero);
+    BOOST_CHECK(r3.second == 5);
+
+    BOOST_CHECK_EXCEPTION(bencode::parse_node(s3.data(), s3.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::parse_node redundant leading zero at offset 5");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_CASE(test_node_interop)
+{
+    BOOST_TEST_MESSAGE("--- Node should be converted to and from values.");
+    std::string s1("d1:a:li1e3:abce1:b:d1:c:i-2eee");
+    auto n1 = bencode::parse_node(s1.data(), s1.size()).first;
+
+    auto value = n1.to_value();
+    std::ostringstream ss;
+    value->dump(ss);
+    BOOST_CHECK(ss.str() == s1);
+
+    bencode::node n2(value);
+    BOOST_CHECK(n2 == n1);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,284 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bencode/parallel.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestParallel)
+
+
+BOOST_AUTO_TEST_CASE(test_split_values)
+{
+    BOOST_TEST_MESSAGE("--- Boundaries of the values should be found.");
+    std::string s1("d2:id:i1eei2e4:spaml1:ae");
+    auto spans1 = bencode::split_values(s1.data(), s1.size());
+
+    BOOST_REQUIRE(spans1.size() == 4);
+    BOOST_CHECK(spans1[0].offset == 0 && spans1[0].length == 10);
+    BOOST_CHECK(spans1[1].offset == 10 && spans1[1].length == 3);
+    BOOST_CHECK(spans1[2].offset == 13 && spans1[2].length == 6);
+    BOOST_CHECK(spans1[3].offset == 19 && spans1[3].length == 5);
+    BOOST_CHECK(std::all_of(spans1.begin(), spans1.end(),
+        [](const bencode::value_span& span) { return span.valid(); }));
+
+
+    BOOST_TEST_MESSAGE("--- Scan should be resynchronized after the "
+        "corrupt value.");
+    std::string s2("d2:id:i1eed2:id:iXeed2:id:i3ee");
+    auto spans2 = bencode::split_values(s2.data(), s2.size());
+
+    BOOST_REQUIRE(spans2.size() == 3);
+    BOOST_CHECK(spans2[0].valid());
+    BOOST_CHECK(!spans2[1].valid());
+    BOOST_CHECK(spans2[1].offset == 10 && spans2[1].length == 10);
+    BOOST_CHECK(spans2[1].error.find("at offset 7") != std::string::npos);
+    BOOST_CHECK(spans2[2].valid());
+    BOOST_CHECK(spans2[2].offset == 20);
+
+
+    BOOST_TEST_MESSAGE("--- Rest of the range should be invalid "
+        "without resynchronization.");
+    auto spans3 = bencode::split_values(s2.data(), s2.size(), false);
+
+    BOOST_REQUIRE(spans3.size() == 2);
+    BOOST_CHECK(!spans3[1].valid());
+    BOOST_CHECK(spans3[1].offset == 10 && spans3[1].length == 20);
+
+
+    BOOST_TEST_MESSAGE("--- Scan should not be resynchronized at the "
+        "containers within the string payloads.");
+    std::string s4("d5:nodes:iXeed2:id:i3ee");
+    auto spans4 = bencode::split_values(s4.data(), s4.size());
+
+    BOOST_REQUIRE(spans4.size() == 2);
+    BOOST_CHECK(!spans4[0].valid());
+    BOOST_CHECK(spans4[0].offset == 0 && spans4[0].length == 13);
+    BOOST_CHECK(spans4[1].valid());
+    BOOST_CHECK(spans4[1].offset == 13 && spans4[1].length == 10);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_parallel_decode)
+{
+    std::string s1;
+    for (int i = 0; i < 200; i++) {
+        s1 += "d2:id:i" + std::to_string(i) + "ee";
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Values should be delivered in order.");
+    bencode::parallel_options o1;
+    o1.threads = 4;
+    std::vector<int64_t> ids1;
+
+    auto n1 = bencode::parallel_decode(s1.data(), s1.size(),
+        [&](bencode::basic_record<char>&& record) {
+            BOOST_REQUIRE(record.ok());
+            BOOST_CHECK(record.index == ids1.size());
+            bencode::dict d(record.value);
+            ids1.push_back(bencode::integer(d["id"]));
+        }, o1);
+
+    BOOST_CHECK(n1 == 200);
+    BOOST_REQUIRE(ids1.size() == 200);
+    for (std::size_t i = 0; i < ids1.size(); i++) {
+        BOOST_CHECK(ids1[i] == int64_t(i));
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Values should be delivered unordered.");
+    bencode::parallel_options o2;
+    o2.threads = 4;
+    o2.ordered = false;
+    std::vector<int64_t> ids2;
+
+    bencode::parallel_decode(s1.data(), s1.size(),
+        [&](bencode::basic_record<char>&& record) {
+            bencode::dict d(record.value);
+            ids2.push_back(bencode::integer(d["id"]));
+        }, o2);
+
+    std::sort(ids2.begin(), ids2.end());
+    BOOST_CHECK(ids1 == ids2);
+
+
+    BOOST_TEST_MESSAGE("--- Corrupt values should be reported.");
+    std::string s3("d2:id:i1eed2:id:iXeed2:id:i3ee");
+    std::vector<bencode::basic_record<char>> records;
+
+    bencode::parallel_decode(s3.data(), s3.size(),
+        [&](bencode::basic_record<char>&& record) {
+            records.push_back(std::move(record));
+        });
+
+    BOOST_REQUIRE(records.size() == 3);
+    BOOST_CHECK(records[0].ok());
+    BOOST_CHECK(!records[1].ok());
+    BOOST_CHECK(records[1].offset == 10);
+    BOOST_CHECK(!records[1].error.empty());
+    BOOST_CHECK(records[2].ok());
+
+
+    BOOST_TEST_MESSAGE("--- Empty range should produce no values.");
+    auto n4 = bencode::parallel_decode(s1.data(), 0,
+        [](bencode::basic_record<char>&&) { BOOST_ERROR("unexpected"); });
+    BOOST_CHECK(n4 == 0);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_parallel_parse)
+{
+    std::string files;
+    for (int i = 0; i < 500; i++) {
+        auto name = "file" + std::to_string(i);
+        files += "d6:length:i" + std::to_string(i) + "e4:path:l" +
+            std::to_string(name.size()) + ":" + name + "ee";
+    }
+
+    std::string s1("d8:announce:3:url4:info:d5:files:l" + files +
+        "e4:name:3:diree");
+
+    auto dump = [](const std::shared_ptr<bencode::basic_value<char>>& value) {
+        std::ostringstream ss;
+        value->dump(ss);
+        return ss.str();
+    };
+
+
+    BOOST_TEST_MESSAGE("--- Large containers should be decoded "
+        "in parallel.");
+    bencode::parallel_options o1;
+    o1.threads = 4;
+    o1.threshold = 64;
+
+    auto r1 = bencode::parallel_parse(s1.data(), s1.size(), o1);
+    BOOST_CHECK(r1.second == s1.size());
+    BOOST_CHECK(dump(r1.first) == s1);
+
+    bencode::dict d1(r1.first);
+    bencode::dict info(d1["info"]);
+    bencode::list l1(info["files"]);
+    BOOST_REQUIRE(l1.size() == 500);
+    for (std::size_t i = 0; i < l1.size(); i++) {
+        bencode::dict f(l1[i]);
+        BOOST_CHECK(bencode::integer(f["length"]) == int64_t(i));
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Small values should be decoded sequentially.");
+    std::string s2("li1ei2eei3e");
+    auto r2 = bencode::parallel_parse(s2.data(), s2.size());
+    BOOST_CHECK(r2.second == 8);
+    BOOST_CHECK(dump(r2.first) == "li1ei2ee");
+
+
+    BOOST_TEST_MESSAGE("--- First value of the duplicate key should "
+        "be kept.");
+    std::string s3("d1:a:i1e1:a:i2e1:b:i3ee");
+    bencode::parallel_options o3;
+    o3.threshold = 1;
+
+    auto r3 = bencode::parallel_parse(s3.data(), s3.size(), o3);
+    BOOST_CHECK(dump(r3.first) == "d1:a:i1e1:b:i3ee");
+
+
+    BOOST_TEST_MESSAGE("--- Containers deeper than the plan depth "
+        "should be decoded sequentially.");
+    std::string s5;
+    for (int i = 0; i < 200; i++) {
+        s5 += "ld1:a:i" + std::to_string(i) + "e1:b:";
+    }
+    s5 += "i0e";
+    for (int i = 0; i < 200; i++) {
+        s5 += "ee";
+    }
+
+    bencode::parallel_options o5;
+    o5.threshold = 1;
+    o5.plan_depth = 16;
+
+    auto r5 = bencode::parallel_parse(s5.data(), s5.size(), o5);
+    BOOST_CHECK(r5.second == s5.size());
+    BOOST_CHECK(dump(r5.first) == s5);
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "malformed value.");
+    std::string s4("li1ei2e");
+    BOOST_CHECK_THROW(bencode::parallel_parse(s4.data(), s4.size(), o3),
+        bencode::encoding_error);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_decode_batch)
+{
+    BOOST_TEST_MESSAGE("--- Batch of the values should be decoded.");
+    std::vector<std::string> buffers;
+    for (int i = 0; i < 100; i++) {
+        buffers.push_back("d2:id:i" + std::to_string(i) + "ee");
+    }
+    buffers[42] = "d2:id:i42e";
+
+    bencode::parallel_options o1;
+    o1.threads = 4;
+
+    auto r1 = bencode::decode_batch(buffers, o1);
+    BOOST_REQUIRE(r1.records.size() == 100);
+    BOOST_CHECK(r1.errors == 1);
+    BOOST_CHECK(r1.throughput() >= 0);
+
+    std::size_t characters = 0;
+    for (std::size_t i = 0; i < r1.records.size(); i++) {
+        auto& record = r1.records[i];
+        BOOST_CHECK(record.index == i);
+
+        if (i == 42) {
+            BOOST_CHECK(!record.ok());
+            BOOST_CHECK(record.error.find("the end of the dictionary")
+                != std::string::npos);
+            continue;
+        }
+
+        BOOST_REQUIRE(record.ok());
+        BOOST_CHECK(record.length == buffers[i].size());
+        characters += record.length;
+
+        bencode::dict d(record.value);
+        BOOST_CHECK(bencode::integer(d["id"]) == int64_t(i));
+    }
+    BOOST_CHECK(r1.characters == characters);
+
+
+    BOOST_TEST_MESSAGE("--- Workers should decode into their own arenas.");
+    auto r3 = bencode::decode_batch<char, int64_t, std::char_traits<char>,
+        bencode::arena_allocator>(buffers, o1);
+    BOOST_REQUIRE(r3.records.size() == 100);
+    BOOST_CHECK(r3.errors == 1);
+    BOOST_CHECK(r3.arenas.size() == 4);
+    BOOST_CHECK(std::any_of(r3.arenas.begin(), r3.arenas.end(),
+        [](const std::shared_ptr<bencode::monotonic_arena>& arena) {
+            return arena->used() > 0;
+        }));
+
+    for (std::size_t i = 0; i < r3.records.size(); i++) {
+        if (i != 42) {
+            bencode::arena_dict d(r3.records[i].value);
+            BOOST_CHECK(bencode::integer(d["id"]) == int64_t(i));
+        }
+    }
+    BOOST_CHECK(r1.arenas.empty());
+
+
+    BOOST_TEST_MESSAGE("--- Empty batch should produce no records.");
+    auto r2 = bencode::decode_batch(std::vector<std::string>());
+    BOOST_CHECK(r2.records.empty());
+    BOOST_CHECK(r2.errors == 0);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
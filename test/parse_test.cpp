@@ -0,0 +1,83 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <cstring>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bencode.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestParse)
+
+
+BOOST_AUTO_TEST_CASE(test_parse_buffer)
+{
+    BOOST_TEST_MESSAGE("--- Bencode value should be decoded "
+        "from the character buffer.");
+    const char* s1 = "d4:name:8:manifold6:pieces:li3ei14eee";
+    auto r1 = bencode::parse<char>(s1, std::strlen(s1));
+    bencode::dict d1(r1.first);
+
+    BOOST_CHECK(r1.second == std::strlen(s1));
+    BOOST_CHECK(bencode::string(d1["name"]) == "manifold");
+
+    bencode::list l1(d1["pieces"]);
+    BOOST_CHECK(bencode::integer(l1[0]) == int64_t(3));
+    BOOST_CHECK(bencode::integer(l1[1]) == int64_t(14));
+
+
+    BOOST_TEST_MESSAGE("--- Only the first value should be consumed "
+        "from the character buffer.");
+    std::string s2("i42e5:tail!");
+    auto r2 = bencode::parse(s2);
+
+    BOOST_CHECK(bencode::integer(r2.first) == int64_t(42));
+    BOOST_CHECK(r2.second == 4);
+
+    auto r3 = bencode::parse<char>(s2.data() + r2.second,
+        s2.data() + s2.size());
+    BOOST_CHECK(bencode::string(r3.first) == "tail!");
+    BOOST_CHECK(r3.second == 7);
+
+
+    BOOST_TEST_MESSAGE("--- Bencode value should be decoded "
+        "from the wide character buffer.");
+    std::wstring s4(L"l5:alphai-7ee");
+    auto r4 = bencode::parse(s4);
+    bencode::wlist l4(r4.first);
+
+    BOOST_CHECK(bencode::wstring(l4[0]) == L"alpha");
+    BOOST_CHECK(bencode::winteger(l4[1]) == int64_t(-7));
+    BOOST_CHECK(r4.second == s4.size());
+}
+
+
+BOOST_AUTO_TEST_CASE(test_parse_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "truncated buffer.");
+    std::vector<char> v1{'l', 'i', '1', 'e'};
+
+    BOOST_CHECK_EXCEPTION(bencode::parse<char>(v1.data(), v1.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the end of the list `e` expected, but `\xff` found");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "string exceeding the buffer.");
+    std::string s2("10:short");
+
+    BOOST_CHECK_EXCEPTION(bencode::parse(s2), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "decoded length is not equal to the real one: `10` != `5`");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,141 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <cstdlib>
+#include <new>
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/pool.hpp>
+
+
+// Count the allocations from the global heap.
+static std::size_t allocations = 0;
+
+
+// The replacements are kept out of line, so the compiler never pairs an
+// inlined std::free with the operator new seen at the call site.
+__attribute__((noinline)) void*
+operator new(std::size_t n)
+{
+    ++allocations;
+    if (auto p = std::malloc(n ? n : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+
+__attribute__((noinline)) void
+operator delete(void* p) noexcept
+{ std::free(p); }
+
+
+__attribute__((noinline)) void
+operator delete(void* p, std::size_t) noexcept
+{ std::free(p); }
+
+
+BOOST_AUTO_TEST_SUITE(TestPool)
+
+
+static std::string
+dump(const std::shared_ptr<bencode::basic_value<char>>& value)
+{
+    std::ostringstream ss;
+    value->dump(ss);
+    return ss.str();
+}
+
+
+BOOST_AUTO_TEST_CASE(test_pool_parse)
+{
+    bencode::node_pool pool;
+
+
+    BOOST_TEST_MESSAGE("--- Values should be decoded by the pool.");
+    std::string s1("d1:a:d2:id:20:abcdefghij0123456789e1:q:4:ping"
+        "1:t:2:aa1:y:1:qe");
+    auto r1 = pool.parse(s1);
+    BOOST_CHECK(r1.second == s1.size());
+    BOOST_CHECK(dump(r1.first) == s1);
+
+
+    BOOST_TEST_MESSAGE("--- Values should be returned to the pool.");
+    r1.first.reset();
+    BOOST_CHECK(pool.cached() == 1);
+
+
+    BOOST_TEST_MESSAGE("--- Same-shaped messages should be decoded "
+        "without allocations.");
+    std::string s2("d1:a:d2:id:20:0123456789abcdefghije1:q:4:ping"
+        "1:t:2:bb1:y:1:qe");
+    for (int i = 0; i < 3; ++i) {
+        auto before = allocations;
+        auto r2 = pool.parse(s2.data(), s2.size());
+        auto count = allocations - before;
+
+        BOOST_CHECK(count == 0);
+        BOOST_CHECK(dump(r2.first) == s2);
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Shape of the recycled value should be "
+        "changed.");
+    std::string s3("d1:b:li1ei2ei3ee1:c:i1ee");
+    auto r3 = pool.parse(s3);
+    BOOST_CHECK(dump(r3.first) == s3);
+    r3.first.reset();
+
+    std::string s4("d1:a:i1e1:b:l1:xd1:k:0:ee1:d:0:e");
+    auto r4 = pool.parse(s4);
+    BOOST_CHECK(dump(r4.first) == s4);
+    r4.first.reset();
+
+    std::string s5("d1:b:li7ee1:a:i1e1:b:i2ee");
+    auto r5 = pool.parse(s5);
+    BOOST_CHECK(dump(r5.first) == "d1:a:i1e1:b:li7eee");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_pool_sharing)
+{
+    bencode::node_pool pool;
+
+
+    BOOST_TEST_MESSAGE("--- Values held outside should not be modified.");
+    std::string s1("d1:a:3:abc1:b:i1ee");
+    auto r1 = pool.parse(s1);
+    auto dict = std::dynamic_pointer_cast<bencode::dict>(r1.first);
+    auto value = (*dict)["a"];
+    r1.first.reset();
+    dict.reset();
+
+    std::string s2("d1:a:3:xyz1:b:i2ee");
+    auto r2 = pool.parse(s2);
+    BOOST_CHECK(dump(r2.first) == s2);
+    BOOST_CHECK(dump(value) == "3:abc");
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "malformed value.");
+    std::string s3("d1:a:i1e");
+    BOOST_CHECK_EXCEPTION(pool.parse(s3),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::node_pool::parse unexpected end of the value "
+                "at offset 8");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Pool should be cleared.");
+    r2.first.reset();
+    BOOST_CHECK(pool.cached() > 0);
+    pool.clear();
+    BOOST_CHECK(pool.cached() == 0);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
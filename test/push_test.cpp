@@ -0,0 +1,106 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/push.hpp>
+#include <bencode/sax.hpp>
+
+
+// Handler, which records the events into the string.
+struct trace_handler
+{
+    std::string trace;
+
+    void on_integer(int64_t value)
+    { trace += "i(" + std::to_string(value) + ")"; }
+
+    void on_string(const char* s, std::size_t n)
+    { trace += "s(" + std::string(s, n) + ")"; }
+
+    void key(const char* s, std::size_t n)
+    { trace += "k(" + std::string(s, n) + ")"; }
+
+    void begin_list() { trace += "["; }
+    void end_list() { trace += "]"; }
+    void begin_dict() { trace += "{"; }
+    void end_dict() { trace += "}"; }
+};
+
+
+BOOST_AUTO_TEST_SUITE(TestPush)
+
+
+BOOST_AUTO_TEST_CASE(test_feed)
+{
+    BOOST_TEST_MESSAGE("--- Value should be parsed from the chunks "
+        "of a single character.");
+    std::string s1("d4:name:11:hello world5:sizes:li100ei-3ee0::0:e");
+    trace_handler h1;
+    bencode::basic_push_parser<char, trace_handler> p1(h1);
+
+    for (std::size_t i = 0; i < s1.size() - 1; ++i) {
+        BOOST_CHECK(p1.feed(&s1[i], 1) == bencode::push_status::need_more);
+    }
+    BOOST_CHECK(p1.feed(&s1[s1.size() - 1], 1) ==
+        bencode::push_status::complete);
+    BOOST_CHECK(h1.trace == "{k(name)s(hello world)k(sizes)"
+        "[i(100)i(-3)]k()s()}");
+    BOOST_CHECK(p1.position() == s1.size());
+
+
+    BOOST_TEST_MESSAGE("--- Values should be parsed from the "
+        "concatenated chunk.");
+    std::string s2("i1e3:abcli2ee");
+    trace_handler h2;
+    bencode::basic_push_parser<char, trace_handler> p2(h2);
+    std::size_t offset = 0;
+
+    while (offset < s2.size()) {
+        BOOST_CHECK(p2.feed(s2.data() + offset, s2.size() - offset) ==
+            bencode::push_status::complete);
+        offset += p2.consumed();
+    }
+    BOOST_CHECK(h2.trace == "i(1)s(abc)[i(2)]");
+
+
+    BOOST_TEST_MESSAGE("--- Tree of the values should be built from "
+        "the chunks.");
+    std::string s3("d3:key:l5:value4:tailee");
+    bencode::value_builder b3;
+    bencode::basic_push_parser<char, bencode::value_builder> p3(b3);
+    std::stringstream ss3;
+
+    BOOST_CHECK(p3.feed(s3.data(), 10) == bencode::push_status::need_more);
+    BOOST_CHECK(p3.feed(s3.data() + 10, s3.size() - 10) ==
+        bencode::push_status::complete);
+
+    b3.value()->dump(ss3);
+    BOOST_CHECK(ss3.str() == s3);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_feed_errors)
+{
+    BOOST_TEST_MESSAGE("--- Error should be reported with the offset "
+        "counted across the chunks.");
+    std::string s1("li1ei01ee");
+    trace_handler h1;
+    bencode::basic_push_parser<char, trace_handler> p1(h1);
+
+    BOOST_CHECK(p1.feed(s1.data(), 6) == bencode::push_status::need_more);
+    BOOST_CHECK(p1.feed(s1.data() + 6, 3) == bencode::push_status::error);
+    BOOST_CHECK(p1.error().find("bencode::push_parser invalid integer "
+        "at offset 7") != std::string::npos);
+    BOOST_CHECK(p1.feed(s1.data(), 1) == bencode::push_status::error);
+
+
+    BOOST_TEST_MESSAGE("--- Parser should be reusable after the reset.");
+    p1.reset();
+    BOOST_CHECK(p1.feed(s1.data(), 4) == bencode::push_status::need_more);
+    BOOST_CHECK(p1.feed("e", 1) == bencode::push_status::complete);
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,166 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <bencode/istream.hpp>
+#include <bencode/reader.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestReader)
+
+
+// Stream buffer, which hands out one character at a time and does not
+// support seeking, so the end of the stream is never known ahead.
+class unseekable_buf : public std::streambuf
+{
+public:
+    explicit
+    unseekable_buf(const std::string& s)
+    : _M_str(s), _M_pos(0)
+    { }
+
+protected:
+    int_type
+    underflow()
+    {
+        if (_M_pos == _M_str.size()) {
+            return traits_type::eof();
+        }
+        _M_ch = _M_str[_M_pos++];
+        setg(&_M_ch, &_M_ch, &_M_ch + 1);
+        return traits_type::to_int_type(_M_ch);
+    }
+
+private:
+    std::string _M_str;
+    std::size_t _M_pos;
+    char _M_ch;
+};
+
+
+BOOST_AUTO_TEST_CASE(test_next)
+{
+    BOOST_TEST_MESSAGE("--- Tokens should be read from the buffer.");
+    std::string s1("d4:name:8:manifold5:sizes:li1ei-2eee");
+    bencode::reader r1(s1.data(), s1.size());
+
+    BOOST_CHECK(r1.type() == bencode::reader_token::none);
+    BOOST_CHECK(r1.next() == bencode::reader_token::begin_dict);
+    BOOST_CHECK(r1.depth() == 1);
+    BOOST_CHECK(r1.next() == bencode::reader_token::key);
+    BOOST_CHECK(r1.string() == "name");
+    BOOST_CHECK(r1.next() == bencode::reader_token::string);
+    BOOST_CHECK(r1.length() == 8);
+    BOOST_CHECK(std::string(r1.data(), r1.length()) == "manifold");
+    BOOST_CHECK(r1.next() == bencode::reader_token::key);
+    BOOST_CHECK(r1.next() == bencode::reader_token::begin_list);
+    BOOST_CHECK(r1.next() == bencode::reader_token::integer);
+    BOOST_CHECK(r1.integer() == 1);
+    BOOST_CHECK(r1.next() == bencode::reader_token::integer);
+    BOOST_CHECK(r1.integer() == -2);
+    BOOST_CHECK(r1.next() == bencode::reader_token::end_list);
+    BOOST_CHECK(r1.next() == bencode::reader_token::end_dict);
+    BOOST_CHECK(r1.depth() == 0);
+    BOOST_CHECK(r1.next() == bencode::reader_token::end);
+    BOOST_CHECK(r1.position() == s1.size());
+
+
+    BOOST_TEST_MESSAGE("--- Tokens should be read from the stream.");
+    std::stringbuf sb2("l3:abc3:defei7e");
+    bencode::istream is2(&sb2);
+    bencode::stream_reader r2(is2);
+    std::vector<std::string> strings;
+
+    BOOST_CHECK(r2.next() == bencode::reader_token::begin_list);
+    while (r2.next() == bencode::reader_token::string) {
+        strings.push_back(r2.string());
+    }
+    BOOST_CHECK(r2.type() == bencode::reader_token::end_list);
+    BOOST_CHECK(strings == std::vector<std::string>({"abc", "def"}));
+    BOOST_CHECK(r2.next() == bencode::reader_token::integer);
+    BOOST_CHECK(r2.integer() == 7);
+    BOOST_CHECK(r2.next() == bencode::reader_token::end);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_skip)
+{
+    BOOST_TEST_MESSAGE("--- Containers should be skipped.");
+    std::string s1("d5:files:ld1:a:i1eel3:abcee6:length:i9ee");
+    bencode::reader r1(s1.data(), s1.size());
+
+    r1.next();
+    BOOST_CHECK(r1.next() == bencode::reader_token::key);
+    BOOST_CHECK(r1.next() == bencode::reader_token::begin_list);
+
+    r1.skip();
+    BOOST_CHECK(r1.type() == bencode::reader_token::end_list);
+    BOOST_CHECK(r1.depth() == 1);
+    BOOST_CHECK(r1.next() == bencode::reader_token::key);
+    BOOST_CHECK(r1.next() == bencode::reader_token::integer);
+    BOOST_CHECK(r1.integer() == 9);
+
+
+    BOOST_TEST_MESSAGE("--- Strings should be read in parts.");
+    std::string s2("10:0123456789i1e");
+    bencode::reader r2(s2.data(), s2.size());
+    char buf[4];
+
+    r2.next();
+    BOOST_CHECK(r2.read(buf, 4) == 4);
+    BOOST_CHECK(std::string(buf, 4) == "0123");
+    BOOST_CHECK(r2.next() == bencode::reader_token::integer);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "truncated value.");
+    std::string s1("li1e");
+    bencode::reader r1(s1.data(), s1.size());
+
+    r1.next();
+    r1.next();
+    BOOST_CHECK_EXCEPTION(r1.next(), bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::reader unexpected end of the value at offset 4");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on reading "
+        "the token of the different type.");
+    std::string s2("i1e");
+    bencode::reader r2(s2.data(), s2.size());
+
+    r2.next();
+    BOOST_CHECK_EXCEPTION(r2.string(), bencode::type_error,
+        [](bencode::type_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "the token is not a string");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "truncated string in the unseekable stream.");
+    unseekable_buf sb3("40000000000:x");
+    std::istream ss3(&sb3);
+    bencode::stream_reader r3(ss3);
+
+    r3.next();
+    BOOST_CHECK_EXCEPTION(r3.string(), bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "unexpected end of the string");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
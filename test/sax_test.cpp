@@ -0,0 +1,142 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/sax.hpp>
+
+
+// Handler, which records the events into the string.
+struct trace_handler
+{
+    std::string trace;
+
+    void on_integer(int64_t value)
+    { trace += "i(" + std::to_string(value) + ")"; }
+
+    void on_string(const char* s, std::size_t n)
+    { trace += "s(" + std::string(s, n) + ")"; }
+
+    void key(const char* s, std::size_t n)
+    { trace += "k(" + std::string(s, n) + ")"; }
+
+    void begin_list() { trace += "["; }
+    void end_list() { trace += "]"; }
+    void begin_dict() { trace += "{"; }
+    void end_dict() { trace += "}"; }
+};
+
+
+// Stream buffer, which hands out one character at a time and does not
+// support seeking, so the end of the stream is never known ahead.
+class unseekable_buf : public std::streambuf
+{
+public:
+    explicit
+    unseekable_buf(const std::string& s)
+    : _M_str(s), _M_pos(0)
+    { }
+
+protected:
+    int_type
+    underflow()
+    {
+        if (_M_pos == _M_str.size()) {
+            return traits_type::eof();
+        }
+        _M_ch = _M_str[_M_pos++];
+        setg(&_M_ch, &_M_ch, &_M_ch + 1);
+        return traits_type::to_int_type(_M_ch);
+    }
+
+private:
+    std::string _M_str;
+    std::size_t _M_pos;
+    char _M_ch;
+};
+
+
+BOOST_AUTO_TEST_SUITE(TestSax)
+
+
+BOOST_AUTO_TEST_CASE(test_sax_parse)
+{
+    BOOST_TEST_MESSAGE("--- Events should be reported for the buffer.");
+    std::string s1("d4:list:li1e2:abe4:name:3:abc5:empty:deei9e");
+    trace_handler h1;
+
+    BOOST_CHECK(bencode::sax_parse(s1.data(), s1.size(), h1) ==
+        s1.size() - 3);
+    BOOST_CHECK(h1.trace == "{k(list)[i(1)s(ab)]k(name)s(abc)k(empty){}}");
+
+
+    BOOST_TEST_MESSAGE("--- Events should be reported for the stream.");
+    std::stringstream ss2(s1);
+    trace_handler h2;
+
+    BOOST_CHECK(bencode::sax_parse(ss2, h2) == s1.size() - 3);
+    BOOST_CHECK(h2.trace == h1.trace);
+    BOOST_CHECK(ss2.peek() == 'i');
+}
+
+
+BOOST_AUTO_TEST_CASE(test_value_builder)
+{
+    BOOST_TEST_MESSAGE("--- Tree of the values should be built "
+        "from the events.");
+    std::string s1("d5:first:li1ei-2ee6:second:d3:key:5:valueee");
+    bencode::value_builder b1;
+    std::stringstream ss1;
+
+    bencode::sax_parse(s1.data(), s1.size(), b1);
+    b1.value()->dump(ss1);
+    BOOST_CHECK(ss1.str() == s1);
+
+
+    BOOST_TEST_MESSAGE("--- Tree of the values should be built "
+        "from the stream.");
+    std::wstringstream ss2(L"l6:строкаi7ee");
+    bencode::wvalue_builder b2;
+
+    bencode::sax_parse(ss2, b2);
+    bencode::wlist l2(b2.value());
+    BOOST_CHECK(l2.size() == 2);
+    BOOST_CHECK(bencode::wstring(l2[0]) == L"строка");
+}
+
+
+BOOST_AUTO_TEST_CASE(test_sax_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "truncated string in the stream.");
+    std::stringstream ss1("l3:abc999:truncatede");
+    trace_handler h1;
+
+    BOOST_CHECK_EXCEPTION(bencode::sax_parse(ss1, h1),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::sax_parse unexpected end of the string");
+            return pos != std::string::npos;
+        });
+    BOOST_CHECK(h1.trace == "[s(abc)");
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "truncated string in the unseekable stream.");
+    unseekable_buf sb2("40000000000:x");
+    std::istream ss2(&sb2);
+    trace_handler h2;
+
+    BOOST_CHECK_EXCEPTION(bencode::sax_parse(ss2, h2),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::sax_parse unexpected end of the string");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,122 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <boost/test/unit_test.hpp>
+#include <bencode/skip.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestSkip)
+
+
+BOOST_AUTO_TEST_CASE(test_skip_buffer)
+{
+    BOOST_TEST_MESSAGE("--- Values of all types should be skipped "
+        "in the character buffer.");
+    std::string s1("i-42e10:0123456789li1ed1:a:l0:eeed4:name:3:abce!");
+
+    BOOST_CHECK(bencode::skip_value(s1.data(), s1.size()) == 5);
+    BOOST_CHECK(bencode::skip_value(s1.data() + 5, 13) == 13);
+    BOOST_CHECK(bencode::skip_value(s1.data() + 18, s1.size() - 18) == 15);
+    BOOST_CHECK(bencode::skip_value(s1.data() + 33, s1.size() - 33) == 14);
+
+
+    BOOST_TEST_MESSAGE("--- Wchar values should be skipped.");
+    std::wstring s2(L"l6:строкаi1ee");
+
+    BOOST_CHECK(bencode::skip_value(s2.data(), s2.size()) == s2.size());
+}
+
+
+BOOST_AUTO_TEST_CASE(test_skip_stream)
+{
+    BOOST_TEST_MESSAGE("--- Values should be extracted from the stream.");
+    std::stringstream ss1("d5:files:l3:abc3:defe6:length:i10eei7e");
+
+    BOOST_CHECK(bencode::skip_value(ss1) == 35);
+    BOOST_CHECK(ss1.peek() == 'i');
+    BOOST_CHECK(bencode::skip_value(ss1) == 3);
+
+
+    BOOST_TEST_MESSAGE("--- Binary payloads should be skipped.");
+    std::stringstream ss2(std::string("li1e5:\x00\xff" "e:\x00" "e3:end",
+        17));
+
+    BOOST_CHECK(bencode::skip_value(ss2) == 12);
+    BOOST_CHECK(ss2.peek() == '3');
+
+
+    BOOST_TEST_MESSAGE("--- Payloads longer than the stream buffer "
+        "should be skipped.");
+    const char* path = "skip_test.bencode";
+    {
+        std::ofstream os(path, std::ios::binary);
+        os << "l100000:" << std::string(100000, 'x') << "i3ee5:tail!";
+    }
+
+    std::ifstream is(path, std::ios::binary);
+    BOOST_CHECK(bencode::skip_value(is) == 100012);
+    BOOST_CHECK(is.peek() == '5');
+
+    is.close();
+    std::remove(path);
+}
+
+
+BOOST_AUTO_TEST_CASE(test_skip_exceptions)
+{
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "truncated string in the stream.");
+    std::stringstream ss1("l10:short");
+
+    BOOST_CHECK_EXCEPTION(bencode::skip_value(ss1), bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::skip_value unexpected end of the string "
+                "at offset 9");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "invalid integer in the stream.");
+    std::stringstream ss2("d1:a:i-0ee");
+
+    BOOST_CHECK_EXCEPTION(bencode::skip_value(ss2), bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "invalid integer at offset 9");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "unexpected symbol in the buffer.");
+    std::string s3("lxe");
+
+    BOOST_CHECK_EXCEPTION(bencode::skip_value(s3.data(), s3.size()),
+        bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "bencode::skip_value unexpected symbol at offset 1");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the "
+        "unterminated list in the stream.");
+    std::stringstream ss4("li1e");
+
+    BOOST_CHECK_EXCEPTION(bencode::skip_value(ss4), bencode::encoding_error,
+        [](bencode::encoding_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "unexpected end of the value at offset 4");
+            return pos != std::string::npos;
+        });
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -9,6 +9,35 @@
 BOOST_AUTO_TEST_SUITE(TestString)
 
 
+// Stream buffer, which hands out one character at a time and does not
+// support seeking, so the end of the stream is never known ahead.
+class unseekable_buf : public std::streambuf
+{
+public:
+    explicit
+    unseekable_buf(const std::string& s)
+    : _M_str(s), _M_pos(0)
+    { }
+
+protected:
+    int_type
+    underflow()
+    {
+        if (_M_pos == _M_str.size()) {
+            return traits_type::eof();
+        }
+        _M_ch = _M_str[_M_pos++];
+        setg(&_M_ch, &_M_ch, &_M_ch + 1);
+        return traits_type::to_int_type(_M_ch);
+    }
+
+private:
+    std::string _M_str;
+    std::size_t _M_pos;
+    char _M_ch;
+};
+
+
 BOOST_AUTO_TEST_CASE(test_load)
 {
     BOOST_TEST_MESSAGE("--- Char string value should be decoded.");
@@ -24,6 +53,82 @@ BOOST_AUTO_TEST_CASE(test_load)
 
     s2.load(ss2);
     BOOST_CHECK(s2 == L"интернационализация");
+
+    BOOST_TEST_MESSAGE("--- Binary string value should be decoded.");
+    std::stringstream ss3(std::string(
+        "10:\x01\n\x00\xff\r\n\x00\x00\x7f\x02i1e", 16));
+    bencode::string s3;
+
+    s3.load(ss3);
+    BOOST_CHECK(s3 == std::string(
+        "\x01\n\x00\xff\r\n\x00\x00\x7f\x02", 10));
+    BOOST_CHECK(ss3.peek() == 'i');
+}
+
+
+BOOST_AUTO_TEST_CASE(test_decode_binary)
+{
+    BOOST_TEST_MESSAGE("--- Binary string value should be decoded "
+        "from the character buffer.");
+    std::string s1("6:\x00\x00\n\x00\xfe\x00", 8);
+    bencode::buffer_cursor c1(s1.data(), s1.size());
+    bencode::string v1;
+
+    v1.decode(c1);
+    BOOST_CHECK(v1 == std::string("\x00\x00\n\x00\xfe\x00", 6));
+    BOOST_CHECK(c1.position() == 8);
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the string "
+        "length exceeding the buffer size.");
+    std::string s2("999999999999:tiny");
+    bencode::buffer_cursor c2(s2.data(), s2.size());
+    bencode::string v2;
+
+    BOOST_CHECK_EXCEPTION(v2.decode(c2), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "decoded length is not equal to the real one: "
+                "`999999999999` != `4`");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on the string "
+        "length exceeding the stream size.");
+    std::stringstream ss3("1099511627776:abc");
+    bencode::string v3;
+
+    BOOST_CHECK_EXCEPTION(v3.load(ss3), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "decoded length is not equal to the real one: "
+                "`1099511627776` != `3`");
+            return pos != std::string::npos;
+        });
+
+
+    BOOST_TEST_MESSAGE("--- Strings should be read by chunks from the "
+        "stream, which end is not known.");
+    std::string s4(10000, 'x');
+    unseekable_buf sb4("10000:" + s4);
+    bencode::streambuf_cursor c4(&sb4);
+    bencode::string v4;
+
+    v4.decode(c4);
+    BOOST_CHECK(v4 == s4);
+
+    unseekable_buf sb5("1099511627776:" + s4);
+    bencode::streambuf_cursor c5(&sb5);
+    bencode::string v5;
+
+    BOOST_CHECK_EXCEPTION(v5.decode(c5), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "decoded length is not equal to the real one: "
+                "`1099511627776` != `10000`");
+            return pos != std::string::npos;
+        });
 }
 
 
@@ -37,7 +142,7 @@ BOOST_AUTO_TEST_CASE(test_load_exceptions)
     BOOST_CHECK_EXCEPTION(s1.load(ss1), bencode::encoding_error,
         [](bencode::encoding_error const& exception) {
             auto pos = std::string(exception.what()).find(
-                "the delimiter `:` expected, but `e` found");
+                "the delimiter `:` expected, but `T` found");
             return pos != std::string::npos;
         });
 
@@ -80,6 +185,19 @@ BOOST_AUTO_TEST_CASE(test_load_exceptions)
                 "decoded length is not equal to the real one: `100` != `34`");
             return pos != std::string::npos;
         });
+
+
+    BOOST_TEST_MESSAGE("--- Exception should be raised on "
+        "leading zeros of the string length.");
+    std::stringstream ss5("05:zeros");
+    bencode::string s5;
+
+    BOOST_CHECK_EXCEPTION(s5.load(ss5), bencode::value_error,
+        [](bencode::value_error const& exception) {
+            auto pos = std::string(exception.what()).find(
+                "length has redundant leading zeros");
+            return pos != std::string::npos;
+        });
 }
 
 
@@ -118,4 +236,61 @@ BOOST_AUTO_TEST_CASE(test_dump)
 }
 
 
+BOOST_AUTO_TEST_CASE(test_short_string)
+{
+    BOOST_TEST_MESSAGE("--- Hashes should be kept inline.");
+    BOOST_CHECK(bencode::string::local_capacity >= 20);
+    BOOST_CHECK(sizeof(bencode::string) <= sizeof(void*) +
+        sizeof(std::string));
+    BOOST_CHECK(sizeof(bencode::wstring) <= sizeof(void*) +
+        sizeof(std::wstring));
+
+
+    BOOST_TEST_MESSAGE("--- Strings should be decoded into the inline "
+        "and the allocated storage.");
+    std::string hash("abcdefghij0123456789");
+    std::string payload(100, 'x');
+    std::stringstream ss1("20:" + hash + "100:" + payload);
+    bencode::string s1, s2;
+
+    s1.load(ss1);
+    s2.load(ss1);
+    BOOST_CHECK(s1 == hash);
+    BOOST_CHECK(s2 == payload);
+    BOOST_CHECK(std::string(s2.cbegin(), s2.cend()) == payload);
+
+
+    BOOST_TEST_MESSAGE("--- Strings should be copied and moved.");
+    bencode::string s3(s2);
+    bencode::string s4(std::move(s2));
+    BOOST_CHECK(s3 == payload);
+    BOOST_CHECK(s4 == payload);
+    BOOST_CHECK(s2.size() == 0);
+
+    s3 = s1;
+    BOOST_CHECK(s3 == hash);
+    s1 = std::move(s4);
+    BOOST_CHECK(s1 == payload);
+
+    s1.assign(hash.data(), 2);
+    BOOST_CHECK(s1 == "ab");
+    BOOST_CHECK(!(s1 == "abc"));
+
+
+    BOOST_TEST_MESSAGE("--- Strings should be assigned from their own "
+        "characters.");
+    std::string chars("0123456789abcdefghijklmnopqrstuvwxyzABCD");
+    bencode::string s5(chars.data(), chars.size());
+    bencode::string s6(s5);
+    bencode::string s7(chars.data(), 10);
+
+    s5.assign(s5.begin() + 5, 10);
+    BOOST_CHECK(s5 == chars.substr(5, 10));
+    s6.assign(s6.begin() + 5, 30);
+    BOOST_CHECK(s6 == chars.substr(5, 30));
+    s7.assign(s7.begin() + 2, 5);
+    BOOST_CHECK(s7 == chars.substr(2, 5));
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
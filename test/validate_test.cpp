@@ -0,0 +1,99 @@
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE Bencode
+
+#include <string>
+#include <system_error>
+#include <boost/test/unit_test.hpp>
+#include <bencode/validate.hpp>
+
+
+BOOST_AUTO_TEST_SUITE(TestValidate)
+
+
+BOOST_AUTO_TEST_CASE(test_validate)
+{
+    BOOST_TEST_MESSAGE("--- Well-formed values should be accepted.");
+    std::string values[] = {
+        "i0e", "i-42e", "0:", "4:spam", "le", "de",
+        "d1:a:li1e3:abcd1:b:leee1:c:0:e",
+        "d1:y:1:q1:q:4:ping1:a:d2:id:20:abcdefghij0123456789ee",
+    };
+
+    for (auto& s : values) {
+        auto r = bencode::validate(s);
+        BOOST_CHECK_MESSAGE(bool(r), s);
+        BOOST_CHECK(r.code == bencode::errc::success);
+        BOOST_CHECK(r.offset == s.size());
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Wide values should be accepted.");
+    std::wstring ws(L"d1:a:li1e3:abcee");
+    BOOST_CHECK(bencode::validate(ws));
+}
+
+
+BOOST_AUTO_TEST_CASE(test_validate_errors)
+{
+    struct {
+        std::string value;
+        bencode::errc code;
+        std::size_t offset;
+    } errors[] = {
+        {"", bencode::errc::unexpected_end, 0},
+        {"li1e", bencode::errc::unexpected_end, 4},
+        {"5:abc", bencode::errc::unexpected_end, 5},
+        {"i12", bencode::errc::unexpected_end, 3},
+        {"x", bencode::errc::unexpected_token, 0},
+        {"e", bencode::errc::unexpected_token, 0},
+        {"d1:a:ee", bencode::errc::unexpected_token, 5},
+        {"i1x2e", bencode::errc::invalid_integer, 2},
+        {"ie", bencode::errc::invalid_integer, 1},
+        {"i-e", bencode::errc::invalid_integer, 1},
+        {"i03e", bencode::errc::leading_zero, 1},
+        {"i-0e", bencode::errc::negative_zero, 1},
+        {"i9223372036854775808e", bencode::errc::integer_overflow, 1},
+        {"i123456789012345678901234e", bencode::errc::integer_overflow, 1},
+        {"03:abc", bencode::errc::leading_zero, 0},
+        {"1-2:ab", bencode::errc::invalid_length, 0},
+        {"-3:abc", bencode::errc::unexpected_token, 0},
+        {"3abc", bencode::errc::missing_delimiter, 1},
+        {"d1:ai1ee", bencode::errc::missing_delimiter, 4},
+        {"di1e:i1ee", bencode::errc::invalid_key, 1},
+        {"i1ei2e", bencode::errc::trailing_data, 3},
+    };
+
+    BOOST_TEST_MESSAGE("--- Kind and offset of the first error "
+        "should be reported.");
+    for (auto& e : errors) {
+        auto r = bencode::validate(e.value);
+        BOOST_CHECK_MESSAGE(r.code == e.code, e.value);
+        BOOST_CHECK_MESSAGE(r.offset == e.offset, e.value);
+        BOOST_CHECK(!r);
+    }
+
+
+    BOOST_TEST_MESSAGE("--- Nesting depth should be limited.");
+    std::string s1(4, 'l');
+    s1 += std::string(4, 'e');
+
+    BOOST_CHECK(bencode::validate(s1, 4));
+    auto r1 = bencode::validate(s1, 3);
+    BOOST_CHECK(r1.code == bencode::errc::depth_exceeded);
+    BOOST_CHECK(r1.offset == 3);
+
+    std::string s2(100000, 'l');
+    auto r2 = bencode::validate(s2, 100000);
+    BOOST_CHECK(r2.code == bencode::errc::depth_exceeded);
+    BOOST_CHECK(r2.offset == 4096);
+
+
+    BOOST_TEST_MESSAGE("--- Error kinds should be converted into "
+        "error codes.");
+    std::error_code ec = bencode::errc::leading_zero;
+    BOOST_CHECK(ec.category().name() == std::string("bencode"));
+    BOOST_CHECK(ec.message() == "redundant leading zero");
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()